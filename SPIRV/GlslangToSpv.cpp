@@ -59,12 +59,12 @@ namespace spv {
 #include "../glslang/MachineIndependent/localintermediate.h"
 #include "../glslang/MachineIndependent/SymbolTable.h"
 #include "../glslang/Include/Common.h"
+#include "../glslang/Include/Counters.h"
 
 // Build-time generated includes
 #include "glslang/build_info.h"
 
 #include <fstream>
-#include <iomanip>
 #include <list>
 #include <map>
 #include <optional>
@@ -72,6 +72,10 @@ namespace spv {
 #include <string>
 #include <vector>
 
+#if ENABLE_OPT
+#include <thread>
+#endif
+
 namespace {
 
 namespace {
@@ -137,6 +141,7 @@ public:
 
     void finishSpv(bool compileOnly);
     void dumpSpv(std::vector<unsigned int>& out);
+    void countBuilderProbes();
 
 protected:
     TGlslangToSpvTraverser(TGlslangToSpvTraverser&);
@@ -266,7 +271,7 @@ protected:
     std::unordered_map<uint32_t, spv::Id> builtInVariableIds;
     std::unordered_set<long long> rValueParameters;  // set of formal function parameters passed as rValues,
                                                // rather than a pointer
-    std::unordered_map<std::string, spv::Function*> functionMap;
+    std::unordered_map<glslang::TString, spv::Function*> functionMap;  // by mangled name, as in call nodes
     std::unordered_map<const glslang::TTypeList*, spv::Id> structMap[glslang::ElpCount][glslang::ElmCount];
     // for mapping glslang block indices to spv indices (e.g., due to hidden members):
     std::unordered_map<long long, std::vector<int>> memberRemapper;
@@ -275,7 +280,7 @@ protected:
     std::stack<bool> breakForLoop;  // false means break for switch
     std::unordered_map<std::string, const glslang::TIntermSymbol*> counterOriginator;
     // Map pointee types for EbtReference to their forward pointers
-    std::map<const glslang::TType *, spv::Id> forwardPointers;
+    std::unordered_map<const glslang::TType *, spv::Id> forwardPointers;
     // Type forcing, for when SPIR-V wants a different type than the AST,
     // requiring local translation to and from SPIR-V type on every access.
     // Maps <builtin-variable-id -> AST-required-type-id>
@@ -1575,8 +1580,9 @@ TGlslangToSpvTraverser::TGlslangToSpvTraverser(unsigned int spvVersion,
         }
         if (glslangIntermediate->getSpv().spv < glslang::EShTargetSpv_1_1 && (int)processes.size() > 0)
             text.append("#line 1\n");
-        text.append(glslangIntermediate->getSourceText());
         builder.setSourceText(text);
+        for (const auto& piece : glslangIntermediate->getSourceText())
+            builder.addSourceText(piece.first, piece.second);
         // Pass name and text for all included files
         const std::map<std::string, std::string>& include_txt = glslangIntermediate->getIncludeText();
         for (auto iItr = include_txt.begin(); iItr != include_txt.end(); ++iItr)
@@ -2017,6 +2023,13 @@ void TGlslangToSpvTraverser::dumpSpv(std::vector<unsigned int>& out)
     builder.dump(out);
 }
 
+// Add the builder's type and constant cache probes to the counters of the compile.
+void TGlslangToSpvTraverser::countBuilderProbes()
+{
+    GLSLANG_COUNT(ECounterSpvTypeProbes, builder.getTypeProbes());
+    GLSLANG_COUNT(ECounterSpvConstantProbes, builder.getConstantProbes());
+}
+
 //
 // Implement the traversal functions.
 //
@@ -4543,16 +4556,14 @@ spv::Id TGlslangToSpvTraverser::convertGlslangToSpvType(const glslang::TType& ty
         {
             // Make the forward pointer, then recurse to convert the structure type, then
             // patch up the forward pointer with a real pointer type.
-            if (forwardPointers.find(type.getReferentType()) == forwardPointers.end()) {
-                spv::Id forwardId = builder.makeForwardPointer(spv::StorageClassPhysicalStorageBufferEXT);
-                forwardPointers[type.getReferentType()] = forwardId;
-            }
-            spvType = forwardPointers[type.getReferentType()];
+            spv::Id& forwardId = forwardPointers[type.getReferentType()];
+            if (forwardId == spv::NoResult)
+                forwardId = builder.makeForwardPointer(spv::StorageClassPhysicalStorageBufferEXT);
+            spvType = forwardId;
             if (!forwardReferenceOnly) {
                 spv::Id referentType = convertGlslangToSpvType(*type.getReferentType());
                 builder.makePointerFromForwardPointer(spv::StorageClassPhysicalStorageBufferEXT,
-                                                      forwardPointers[type.getReferentType()],
-                                                      referentType);
+                                                      spvType, referentType);
             }
         }
         break;
@@ -5582,7 +5593,7 @@ void TGlslangToSpvTraverser::makeFunctions(const glslang::TIntermSequence& glslF
             function->setImplicitThis();
 
         // Track function to emit/call later
-        functionMap[glslFunction->getName().c_str()] = function;
+        functionMap[glslFunction->getName()] = function;
 
         // Set the parameter id's
         for (int p = 0; p < (int)parameters.size(); ++p) {
@@ -5667,7 +5678,7 @@ void TGlslangToSpvTraverser::handleFunctionEntry(const glslang::TIntermAggregate
 {
     // SPIR-V functions should already be in the functionMap from the prepass
     // that called makeFunctions().
-    currentFunction = functionMap[node->getName().c_str()];
+    currentFunction = functionMap[node->getName()];
     spv::Block* functionBlock = currentFunction->getEntryBlock();
     builder.setBuildPoint(functionBlock);
     builder.enterFunction(currentFunction);
@@ -6406,9 +6417,10 @@ spv::Id TGlslangToSpvTraverser::createImageTextureFunctionCall(glslang::TIntermO
 spv::Id TGlslangToSpvTraverser::handleUserFunctionCall(const glslang::TIntermAggregate* node)
 {
     // Grab the function's pointer from the previously created function
-    spv::Function* function = functionMap[node->getName().c_str()];
-    if (! function)
+    const auto it = functionMap.find(node->getName());
+    if (it == functionMap.end() || it->second == nullptr)
         return 0;
+    spv::Function* function = it->second;
 
     const glslang::TIntermSequence& glslangArgs = node->getSequence();
     const glslang::TQualifierList& qualifiers = node->getQualifierList();
@@ -10320,10 +10332,7 @@ bool OutputSpvBin(const std::vector<unsigned int>& spirv, const char* baseName)
         printf("ERROR: Failed to open file: %s\n", baseName);
         return false;
     }
-    for (int i = 0; i < (int)spirv.size(); ++i) {
-        unsigned int word = spirv[i];
-        out.write((const char*)&word, 4);
-    }
+    out.write((const char*)spirv.data(), spirv.size() * sizeof(unsigned int));
     out.close();
     return true;
 }
@@ -10337,30 +10346,45 @@ bool OutputSpvHex(const std::vector<unsigned int>& spirv, const char* baseName,
         printf("ERROR: Failed to open file: %s\n", baseName);
         return false;
     }
-    out << "\t// " <<
-        GetSpirvGeneratorVersion() <<
-        GLSLANG_VERSION_MAJOR << "." << GLSLANG_VERSION_MINOR << "." << GLSLANG_VERSION_PATCH <<
-        GLSLANG_VERSION_FLAVOR << std::endl;
+    std::string text = "\t// " + std::to_string(GetSpirvGeneratorVersion()) +
+        std::to_string(GLSLANG_VERSION_MAJOR) + "." + std::to_string(GLSLANG_VERSION_MINOR) + "." +
+        std::to_string(GLSLANG_VERSION_PATCH) + GLSLANG_VERSION_FLAVOR + "\n";
     if (varName != nullptr) {
-        out << "\t #pragma once" << std::endl;
-        out << "const uint32_t " << varName << "[] = {" << std::endl;
+        text += "\t #pragma once\n";
+        text.append("const uint32_t ").append(varName).append("[] = {\n");
     }
+    out.write(text.data(), text.size());
+
+    // Format whole lines of "0x%08x," into a buffer, flushing it to the file as it fills
+    static const char hexDigits[] = "0123456789abcdef";
     const int WORDS_PER_LINE = 8;
-    for (int i = 0; i < (int)spirv.size(); i += WORDS_PER_LINE) {
-        out << "\t";
-        for (int j = 0; j < WORDS_PER_LINE && i + j < (int)spirv.size(); ++j) {
-            const unsigned int word = spirv[i + j];
-            out << "0x" << std::hex << std::setw(8) << std::setfill('0') << word;
-            if (i + j + 1 < (int)spirv.size()) {
-                out << ",";
-            }
-        }
-        out << std::endl;
-    }
-    if (varName != nullptr) {
-        out << "};";
-        out << std::endl;
-    }
+    const size_t maxLineSize = 2 + WORDS_PER_LINE * 11;  // tab, words with commas, newline
+    const size_t bufferSize = 1 << 16;
+    std::unique_ptr<char[]> buffer(new char[bufferSize]);
+    size_t used = 0;
+    for (size_t i = 0; i < spirv.size(); i += WORDS_PER_LINE) {
+        if (bufferSize - used < maxLineSize) {
+            out.write(buffer.get(), used);
+            used = 0;
+        }
+        char* c = buffer.get() + used;
+        *c++ = '\t';
+        for (size_t j = i; j < i + WORDS_PER_LINE && j < spirv.size(); ++j) {
+            const unsigned int word = spirv[j];
+            *c++ = '0';
+            *c++ = 'x';
+            for (int shift = 28; shift >= 0; shift -= 4)
+                *c++ = hexDigits[(word >> shift) & 0xf];
+            if (j + 1 < spirv.size())
+                *c++ = ',';
+        }
+        *c++ = '\n';
+        used = c - buffer.get();
+    }
+    out.write(buffer.get(), used);
+
+    if (varName != nullptr)
+        out << "};\n";
     out.close();
     return true;
 }
@@ -10386,19 +10410,39 @@ void GlslangToSpv(const TIntermediate& intermediate, std::vector<unsigned int>&
     if (options == nullptr)
         options = &defaultOptions;
 
+    // count into the caller's logger, never into the (possibly frozen) program
+    TCounterScope counterScope(logger != nullptr ? &logger->getCounters() : nullptr);
+
     GetThreadPoolAllocator().push();
 
     TGlslangToSpvTraverser it(intermediate.getSpv().spv, &intermediate, logger, *options);
     root->traverse(&it);
     it.finishSpv(options->compileOnly);
     it.dumpSpv(spirv);
+    it.countBuilderProbes();
 
 #if ENABLE_OPT
     // If from HLSL, run spirv-opt to "legalize" the SPIR-V for Vulkan
     // eg. forward and remove memory writes of opaque types.
     bool prelegalization = intermediate.getSource() == EShSourceHlsl;
+    bool validated = false;
     if ((prelegalization || options->optimizeSize) && !options->disableOptimizer) {
-        SpirvToolsTransform(intermediate, spirv, logger, options);
+        if (options->validate && options->validateConcurrently) {
+            // Validating the optimizer's input does not depend on the optimizer's result,
+            // so check a copy of it on a helper thread while the optimizer runs.  The
+            // helper logs privately; its messages are appended once the optimizer is done,
+            // keeping the log in the same order as the sequential path.
+            std::vector<unsigned int> unoptimized(spirv);
+            spv::SpvBuildLogger validationLogger;
+            std::thread validator([&intermediate, &unoptimized, &validationLogger, prelegalization]() {
+                SpirvToolsValidate(intermediate, unoptimized, &validationLogger, prelegalization);
+            });
+            SpirvToolsTransform(intermediate, spirv, logger, options);
+            validator.join();
+            logger->append(validationLogger);
+            validated = !options->validateOptimized;
+        } else
+            SpirvToolsTransform(intermediate, spirv, logger, options);
         prelegalization = false;
     }
     else if (options->stripDebugInfo) {
@@ -10406,7 +10450,7 @@ void GlslangToSpv(const TIntermediate& intermediate, std::vector<unsigned int>&
         SpirvToolsStripDebugInfo(intermediate, spirv, logger);
     }
 
-    if (options->validate)
+    if (options->validate && !validated)
         SpirvToolsValidate(intermediate, spirv, logger, prelegalization);
 
     if (options->disassemble)
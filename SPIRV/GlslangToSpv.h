@@ -53,6 +53,10 @@ struct SpvOptions {
     bool emitNonSemanticShaderDebugInfo {false};
     bool emitNonSemanticShaderDebugSource{ false };
     bool compileOnly{false};
+    // Validate the module handed to the optimizer on a helper thread while the optimizer runs.
+    // The optimized result is only validated as well when validateOptimized is set.
+    bool validateConcurrently{false};
+    bool validateOptimized{false};
 };
 
 void GetSpirvVersion(std::string&);
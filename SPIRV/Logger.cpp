@@ -52,6 +52,18 @@ void SpvBuildLogger::missingFunctionality(const std::string& f)
         missingFeatures.push_back(f);
 }
 
+void SpvBuildLogger::append(const SpvBuildLogger& other)
+{
+    for (auto it = other.tbdFeatures.cbegin(); it != other.tbdFeatures.cend(); ++it)
+        tbdFunctionality(*it);
+    for (auto it = other.missingFeatures.cbegin(); it != other.missingFeatures.cend(); ++it)
+        missingFunctionality(*it);
+    warnings.insert(warnings.end(), other.warnings.cbegin(), other.warnings.cend());
+    errors.insert(errors.end(), other.errors.cbegin(), other.errors.cend());
+    for (int c = 0; c < glslang::ECounterCount; ++c)
+        counters.count[c] += other.counters.count[c];
+}
+
 std::string SpvBuildLogger::getAllMessages() const {
     std::ostringstream messages;
     for (auto it = tbdFeatures.cbegin(); it != tbdFeatures.cend(); ++it)
@@ -38,6 +38,8 @@
 #include <string>
 #include <vector>
 
+#include "../glslang/Public/ShaderLang.h"
+
 namespace spv {
 
 // A class for holding all SPIR-V build status messages, including
@@ -56,10 +58,17 @@ public:
     // Logs an error.
     void error(const std::string& e) { errors.push_back(e); }
 
+    // Appends all messages and counts of another logger, keeping each category in order.
+    void append(const SpvBuildLogger& other);
+
     // Returns all messages accumulated in the order of:
     // TBD functionalities, missing functionalities, warnings, errors.
     std::string getAllMessages() const;
 
+    // Counts of the GlslangToSpv() runs logged here; see glslang::TCompileCounters
+    glslang::TCompileCounters& getCounters() { return counters; }
+    const glslang::TCompileCounters& getCounters() const { return counters; }
+
 private:
     SpvBuildLogger(const SpvBuildLogger&);
 
@@ -67,6 +76,7 @@ private:
     std::vector<std::string> missingFeatures;
     std::vector<std::string> warnings;
     std::vector<std::string> errors;
+    glslang::TCompileCounters counters;
 };
 
 } // end spv namespace
@@ -38,6 +38,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include "../glslang/Include/Common.h"
 
 namespace spv {
@@ -528,7 +529,36 @@ namespace spv {
         }
     }
 
-    int spirvbin_t::processInstruction(unsigned word, instfn_t instFn, idfn_t idFn)
+    // Decode every instruction's word count once, recording where each instruction starts
+    void spirvbin_t::buildInstIndex()
+    {
+        instPos.clear();
+
+        const spirword_t* words = spv.data();
+        const unsigned    size  = unsigned(spv.size());
+
+        // One position per instruction is at most one per word, so a single allocation suffices
+        instPos.reserve(size > unsigned(header_size) ? size - header_size : 0);
+
+        for (unsigned word = header_size; word < size; ) {
+            const unsigned wordCount = opWordCount(words[word]);
+
+            if (wordCount == 0) {
+                error("spir instruction with zero word count");
+                return;
+            }
+
+            if (wordCount > size - word) {
+                error("spir instruction terminated too early");
+                return;
+            }
+
+            instPos.push_back(word);
+            word += wordCount;
+        }
+    }
+
+    int spirvbin_t::processInstruction(unsigned word, const instfn_t& instFn, const idfn_t& idFn)
     {
         const auto     instructionStart = word;
         const unsigned wordCount = asWordCount(instructionStart);
@@ -703,11 +733,13 @@ namespace spv {
         begin = (begin == 0 ? header_size          : begin);
         end   = (end   == 0 ? unsigned(spv.size()) : end);
 
+        // Instruction boundaries come from the index, so there's no word count chain to follow.
         // basic parsing and InstructionDesc table borrowed from SpvDisassemble.cpp...
-        unsigned nextInst = unsigned(spv.size());
+        const auto first = std::lower_bound(instPos.begin(), instPos.end(), begin);
+        const auto last  = std::lower_bound(first, instPos.end(), end);
 
-        for (unsigned word = begin; word < end; word = nextInst) {
-            nextInst = processInstruction(word, instFn, idFn);
+        for (auto inst = first; inst != last; ++inst) {
+            processInstruction(*inst, instFn, idFn);
 
             if (errorLatch)
                 return *this;
@@ -1425,20 +1457,39 @@ namespace spv {
         // Sort strip ranges in order of traversal
         std::sort(stripRange.begin(), stripRange.end());
 
-        // Allocate a new binary big enough to hold old binary
-        // We'll step this iterator through the strip ranges as we go through the binary
-        auto strip_it = stripRange.begin();
+        // Slide each kept span down over the stripped words in one forward sweep, moving the
+        // instruction index along with it.  Ranges may overlap (e.g., a stripped instruction
+        // inside a stripped function), so 'keptFrom' never moves backwards.
+        auto     inst        = instPos.begin();
+        auto     keptInst    = instPos.begin();
+        unsigned keptFrom    = 0;
+        unsigned strippedPos = 0;
+
+        const auto keep = [&](unsigned spanEnd) {
+            const unsigned shift = keptFrom - strippedPos;
+            for (; inst != instPos.end() && *inst < spanEnd; ++inst)
+                *keptInst++ = *inst - shift;
+
+            if (strippedPos != keptFrom)
+                memmove(spv.data() + strippedPos, spv.data() + keptFrom, (spanEnd - keptFrom) * sizeof(spirword_t));
+            strippedPos += spanEnd - keptFrom;
+        };
 
-        int strippedPos = 0;
-        for (unsigned word = 0; word < unsigned(spv.size()); ++word) {
-            while (strip_it != stripRange.end() && word >= strip_it->second)
-                ++strip_it;
+        for (const auto& range : stripRange) {
+            if (range.first > keptFrom)
+                keep(range.first);
 
-            if (strip_it == stripRange.end() || word < strip_it->first || word >= strip_it->second)
-                spv[strippedPos++] = spv[word];
+            if (range.second > keptFrom) {
+                keptFrom = range.second;
+                while (inst != instPos.end() && *inst < keptFrom)
+                    ++inst;
+            }
         }
 
+        keep(unsigned(spv.size()));
+
         spv.resize(strippedPos);
+        instPos.erase(keptInst, instPos.end());
         stripRange.clear();
 
         buildLocalMaps();
@@ -1453,6 +1504,11 @@ namespace spv {
         spv::Parameterize();
 
         validate();       // validate header
+        if (errorLatch) return;
+
+        buildInstIndex(); // find instruction boundaries
+        if (errorLatch) return;
+
         buildLocalMaps(); // build ID maps
 
         msg(3, 4, std::string("ID bound: ") + std::to_string(bound()));
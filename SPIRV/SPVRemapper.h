@@ -206,9 +206,10 @@ private:
    std::uint32_t hashType(unsigned typeStart) const;
 
    spirvbin_t& process(instfn_t, idfn_t, unsigned begin = 0, unsigned end = 0);
-   int         processInstruction(unsigned word, instfn_t, idfn_t);
+   int         processInstruction(unsigned word, const instfn_t&, const idfn_t&);
 
    void        validate() const;
+   void        buildInstIndex();      // find the start of every instruction
    void        mapTypeConst();
    void        mapFnBodies();
    void        optLoadStore();
@@ -228,6 +229,10 @@ private:
 
    std::vector<spirword_t> spv;      // SPIR words
 
+   // Word positions of each instruction after the header, in order.  Built once per binary
+   // and kept in step with it by strip(), so later passes never re-decode word counts.
+   std::vector<unsigned>   instPos;
+
    std::vector<std::string> stripWhiteList;
 
    namemap_t               nameMap;  // ID names from OpName
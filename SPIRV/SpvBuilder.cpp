@@ -41,6 +41,7 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 
 #include <unordered_set>
 #include <algorithm>
@@ -150,6 +151,7 @@ Id Builder::makePointer(StorageClass storageClass, Id pointee)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypePointer].size(); ++t) {
         type = groupedTypes[OpTypePointer][t];
+        countTypeProbe();
         if (type->getImmediateOperand(0) == (unsigned)storageClass &&
             type->getIdOperand(1) == pointee)
             return type->getResultId();
@@ -195,6 +197,7 @@ Id Builder::makePointerFromForwardPointer(StorageClass storageClass, Id forwardP
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypePointer].size(); ++t) {
         type = groupedTypes[OpTypePointer][t];
+        countTypeProbe();
         if (type->getImmediateOperand(0) == (unsigned)storageClass &&
             type->getIdOperand(1) == pointee)
             return type->getResultId();
@@ -226,6 +229,7 @@ Id Builder::makeIntegerType(int width, bool hasSign)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeInt].size(); ++t) {
         type = groupedTypes[OpTypeInt][t];
+        countTypeProbe();
         if (type->getImmediateOperand(0) == (unsigned)width &&
             type->getImmediateOperand(1) == (hasSign ? 1u : 0u))
             return type->getResultId();
@@ -268,6 +272,7 @@ Id Builder::makeFloatType(int width)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeFloat].size(); ++t) {
         type = groupedTypes[OpTypeFloat][t];
+        countTypeProbe();
         if (type->getImmediateOperand(0) == (unsigned)width)
             return type->getResultId();
     }
@@ -335,6 +340,7 @@ Id Builder::makeStructResultType(Id type0, Id type1)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeStruct].size(); ++t) {
         type = groupedTypes[OpTypeStruct][t];
+        countTypeProbe();
         if (type->getNumOperands() != 2)
             continue;
         if (type->getIdOperand(0) != type0 ||
@@ -357,6 +363,7 @@ Id Builder::makeVectorType(Id component, int size)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeVector].size(); ++t) {
         type = groupedTypes[OpTypeVector][t];
+        countTypeProbe();
         if (type->getIdOperand(0) == component &&
             type->getImmediateOperand(1) == (unsigned)size)
             return type->getResultId();
@@ -390,6 +397,7 @@ Id Builder::makeMatrixType(Id component, int cols, int rows)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeMatrix].size(); ++t) {
         type = groupedTypes[OpTypeMatrix][t];
+        countTypeProbe();
         if (type->getIdOperand(0) == column &&
             type->getImmediateOperand(1) == (unsigned)cols)
             return type->getResultId();
@@ -419,6 +427,7 @@ Id Builder::makeCooperativeMatrixTypeKHR(Id component, Id scope, Id rows, Id col
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeCooperativeMatrixKHR].size(); ++t) {
         type = groupedTypes[OpTypeCooperativeMatrixKHR][t];
+        countTypeProbe();
         if (type->getIdOperand(0) == component &&
             type->getIdOperand(1) == scope &&
             type->getIdOperand(2) == rows &&
@@ -448,6 +457,7 @@ Id Builder::makeCooperativeMatrixTypeNV(Id component, Id scope, Id rows, Id cols
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeCooperativeMatrixNV].size(); ++t) {
         type = groupedTypes[OpTypeCooperativeMatrixNV][t];
+        countTypeProbe();
         if (type->getIdOperand(0) == component && type->getIdOperand(1) == scope && type->getIdOperand(2) == rows &&
             type->getIdOperand(3) == cols)
             return type->getResultId();
@@ -484,6 +494,7 @@ Id Builder::makeGenericType(spv::Op opcode, std::vector<spv::IdImmediate>& opera
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[opcode].size(); ++t) {
         type = groupedTypes[opcode][t];
+        countTypeProbe();
         if (static_cast<size_t>(type->getNumOperands()) != operands.size())
             continue; // Number mismatch, find next
 
@@ -522,6 +533,7 @@ Id Builder::makeArrayType(Id element, Id sizeId, int stride)
         // try to find existing type
         for (int t = 0; t < (int)groupedTypes[OpTypeArray].size(); ++t) {
             type = groupedTypes[OpTypeArray][t];
+            countTypeProbe();
             if (type->getIdOperand(0) == element &&
                 type->getIdOperand(1) == sizeId)
                 return type->getResultId();
@@ -568,6 +580,7 @@ Id Builder::makeFunctionType(Id returnType, const std::vector<Id>& paramTypes)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeFunction].size(); ++t) {
         type = groupedTypes[OpTypeFunction][t];
+        countTypeProbe();
         if (type->getIdOperand(0) != returnType || (int)paramTypes.size() != type->getNumOperands() - 1)
             continue;
         bool mismatch = false;
@@ -647,6 +660,7 @@ Id Builder::makeImageType(Id sampledType, Dim dim, bool depth, bool arrayed, boo
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeImage].size(); ++t) {
         type = groupedTypes[OpTypeImage][t];
+        countTypeProbe();
         if (type->getIdOperand(0) == sampledType &&
             type->getImmediateOperand(1) == (unsigned int)dim &&
             type->getImmediateOperand(2) == (  depth ? 1u : 0u) &&
@@ -743,6 +757,7 @@ Id Builder::makeSampledImageType(Id imageType)
     Instruction* type;
     for (int t = 0; t < (int)groupedTypes[OpTypeSampledImage].size(); ++t) {
         type = groupedTypes[OpTypeSampledImage][t];
+        countTypeProbe();
         if (type->getIdOperand(0) == imageType)
             return type->getResultId();
     }
@@ -1093,7 +1108,7 @@ Id Builder::makeDebugSource(const Id fileName) {
     if (emitNonSemanticShaderDebugSource) {
         spv::Id sourceId = 0;
         if (fileName == mainFileId) {
-            sourceId = getStringId(sourceText);
+            sourceId = getStringId(getMainSourceText());
         } else {
             auto incItr = includeFiles.find(fileName);
             if (incItr != includeFiles.end()) {
@@ -1484,6 +1499,7 @@ Id Builder::findScalarConstant(Op typeClass, Op opcode, Id typeId, unsigned valu
     Instruction* constant;
     for (int i = 0; i < (int)groupedConstants[typeClass].size(); ++i) {
         constant = groupedConstants[typeClass][i];
+        countConstantProbe();
         if (constant->getOpCode() == opcode &&
             constant->getTypeId() == typeId &&
             constant->getImmediateOperand(0) == value)
@@ -1499,6 +1515,7 @@ Id Builder::findScalarConstant(Op typeClass, Op opcode, Id typeId, unsigned v1,
     Instruction* constant;
     for (int i = 0; i < (int)groupedConstants[typeClass].size(); ++i) {
         constant = groupedConstants[typeClass][i];
+        countConstantProbe();
         if (constant->getOpCode() == opcode &&
             constant->getTypeId() == typeId &&
             constant->getImmediateOperand(0) == v1 &&
@@ -1587,6 +1604,7 @@ Id Builder::makeBoolConstant(bool b, bool specConstant)
         Id existing = 0;
         for (int i = 0; i < (int)groupedConstants[OpTypeBool].size(); ++i) {
             constant = groupedConstants[OpTypeBool][i];
+            countConstantProbe();
             if (constant->getTypeId() == typeId && constant->getOpCode() == opcode)
                 existing = constant->getResultId();
         }
@@ -1773,6 +1791,7 @@ Id Builder::findCompositeConstant(Op typeClass, Id typeId, const std::vector<Id>
     bool found = false;
     for (int i = 0; i < (int)groupedConstants[typeClass].size(); ++i) {
         constant = groupedConstants[typeClass][i];
+        countConstantProbe();
 
         if (constant->getTypeId() != typeId)
             continue;
@@ -1800,6 +1819,7 @@ Id Builder::findStructConstant(Id typeId, const std::vector<Id>& comps)
     bool found = false;
     for (int i = 0; i < (int)groupedStructConstants[typeId].size(); ++i) {
         constant = groupedStructConstants[typeId][i];
+        countConstantProbe();
 
         // same contents?
         bool mismatch = false;
@@ -1948,23 +1968,14 @@ void Builder::addExecutionModeId(Function* entryPoint, ExecutionMode mode, const
 
 void Builder::addName(Id id, const char* string)
 {
-    Instruction* name = new Instruction(OpName);
-    name->reserveOperands(2);
-    name->addIdOperand(id);
-    name->addStringOperand(string);
-
-    names.push_back(std::unique_ptr<Instruction>(name));
+    assert(id);
+    names.push_back({ id, false, 0, &internString(string).first });
 }
 
 void Builder::addMemberName(Id id, int memberNumber, const char* string)
 {
-    Instruction* name = new Instruction(OpMemberName);
-    name->reserveOperands(3);
-    name->addIdOperand(id);
-    name->addImmediateOperand(memberNumber);
-    name->addStringOperand(string);
-
-    names.push_back(std::unique_ptr<Instruction>(name));
+    assert(id);
+    names.push_back({ id, true, (unsigned int)memberNumber, &internString(string).first });
 }
 
 void Builder::addDecoration(Id id, Decoration decoration, int num)
@@ -4041,57 +4052,148 @@ Id Builder::accessChainGetInferredType()
     return type;
 }
 
+// Words of a string literal of 'size' characters, which always has room for a nul
+static size_t stringWordCount(size_t size) { return size / 4 + 1; }
+
+// Packs 'size' characters the way Instruction::addStringOperand() does, continuing the partly
+// filled 'word'; the caller writes the last word, which holds the nul.
+static unsigned int* packString(const char* str, size_t size, unsigned int& word, unsigned int& shiftAmount,
+                                unsigned int* out)
+{
+    for (size_t c = 0; c < size; ++c) {
+        word |= ((unsigned int)str[c]) << shiftAmount;
+        shiftAmount += 8;
+        if (shiftAmount == 32) {
+            *out++ = word;
+            word = 0;
+            shiftAmount = 0;
+        }
+    }
+
+    return out;
+}
+
+// Packs 'size' characters and their nul the way Instruction::addStringOperand() does
+static unsigned int* dumpString(const char* str, size_t size, unsigned int* out)
+{
+    unsigned int word = 0;
+    unsigned int shiftAmount = 0;
+    out = packString(str, size, word, shiftAmount, out);
+    *out++ = word;
+
+    return out;
+}
+
+static unsigned int* dumpStringInstruction(Op opCode, const char* str, unsigned int* out)
+{
+    const size_t size = strlen(str);
+    *out++ = (unsigned int)((1 + stringWordCount(size)) << WordCountShift) | opCode;
+
+    return dumpString(str, size, out);
+}
+
+size_t Builder::getWordCount() const
+{
+    std::vector<const Block*> blockOrder;
+
+    return getWordCount(blockOrder);
+}
+
+size_t Builder::getWordCount(std::vector<const Block*>& blockOrder) const
+{
+    size_t wordCount = 5;  // header
+
+    wordCount += 2 * capabilities.size();
+    for (auto it = extensions.cbegin(); it != extensions.cend(); ++it)
+        wordCount += 1 + stringWordCount(it->size());
+    wordCount += getWordCount(imports);
+    wordCount += 3;  // OpMemoryModel
+    wordCount += getWordCount(entryPoints);
+    wordCount += getWordCount(executionModes);
+    wordCount += getWordCount(strings);
+    wordCount += getSourceWordCount();
+    for (int e = 0; e < (int)sourceExtensions.size(); ++e)
+        wordCount += 1 + stringWordCount(strlen(sourceExtensions[e]));
+    wordCount += getNamesWordCount();
+    for (int i = 0; i < (int)moduleProcesses.size(); ++i)
+        wordCount += 1 + stringWordCount(strlen(moduleProcesses[i]));
+    wordCount += getWordCount(decorations);
+    wordCount += getWordCount(constantsTypesGlobals);
+    wordCount += getWordCount(externals);
+    wordCount += module.getWordCount(blockOrder);
+
+    return wordCount;
+}
+
 void Builder::dump(std::vector<unsigned int>& out) const
+{
+    std::vector<const Block*> blockOrder;
+    const size_t start = out.size();
+    out.resize(start + getWordCount(blockOrder));
+    const unsigned int* end = dump(out.data() + start, blockOrder);
+    assert(end == out.data() + out.size());
+    (void)end;
+}
+
+size_t Builder::dump(unsigned int* words, size_t capacity) const
+{
+    std::vector<const Block*> blockOrder;
+    const size_t wordCount = getWordCount(blockOrder);
+    if (wordCount > capacity)
+        return 0;
+
+    const unsigned int* end = dump(words, blockOrder);
+    assert(end == words + wordCount);
+    (void)end;
+
+    return wordCount;
+}
+
+unsigned int* Builder::dump(unsigned int* out, const std::vector<const Block*>& blockOrder) const
 {
     // Header, before first instructions:
-    out.push_back(MagicNumber);
-    out.push_back(spvVersion);
-    out.push_back(builderNumber);
-    out.push_back(uniqueId + 1);
-    out.push_back(0);
+    *out++ = MagicNumber;
+    *out++ = spvVersion;
+    *out++ = builderNumber;
+    *out++ = uniqueId + 1;
+    *out++ = 0;
 
     // Capabilities
     for (auto it = capabilities.cbegin(); it != capabilities.cend(); ++it) {
-        Instruction capInst(0, 0, OpCapability);
-        capInst.addImmediateOperand(*it);
-        capInst.dump(out);
+        *out++ = (2 << WordCountShift) | OpCapability;
+        *out++ = *it;
     }
 
-    for (auto it = extensions.cbegin(); it != extensions.cend(); ++it) {
-        Instruction extInst(0, 0, OpExtension);
-        extInst.addStringOperand(it->c_str());
-        extInst.dump(out);
-    }
+    for (auto it = extensions.cbegin(); it != extensions.cend(); ++it)
+        out = dumpStringInstruction(OpExtension, it->c_str(), out);
 
-    dumpInstructions(out, imports);
-    Instruction memInst(0, 0, OpMemoryModel);
-    memInst.addImmediateOperand(addressModel);
-    memInst.addImmediateOperand(memoryModel);
-    memInst.dump(out);
+    out = dumpInstructions(out, imports);
+    *out++ = (3 << WordCountShift) | OpMemoryModel;
+    *out++ = addressModel;
+    *out++ = memoryModel;
 
     // Instructions saved up while building:
-    dumpInstructions(out, entryPoints);
-    dumpInstructions(out, executionModes);
+    out = dumpInstructions(out, entryPoints);
+    out = dumpInstructions(out, executionModes);
 
     // Debug instructions
-    dumpInstructions(out, strings);
-    dumpSourceInstructions(out);
-    for (int e = 0; e < (int)sourceExtensions.size(); ++e) {
-        Instruction sourceExtInst(0, 0, OpSourceExtension);
-        sourceExtInst.addStringOperand(sourceExtensions[e]);
-        sourceExtInst.dump(out);
-    }
-    dumpInstructions(out, names);
-    dumpModuleProcesses(out);
+    out = dumpInstructions(out, strings);
+    out = dumpSourceInstructions(out);
+    for (int e = 0; e < (int)sourceExtensions.size(); ++e)
+        out = dumpStringInstruction(OpSourceExtension, sourceExtensions[e], out);
+    out = dumpNames(out);
+    out = dumpModuleProcesses(out);
 
     // Annotation instructions
-    dumpInstructions(out, decorations);
+    out = dumpInstructions(out, decorations);
 
-    dumpInstructions(out, constantsTypesGlobals);
-    dumpInstructions(out, externals);
+    out = dumpInstructions(out, constantsTypesGlobals);
+    out = dumpInstructions(out, externals);
 
     // The functions
-    module.dump(out);
+    out = module.dump(out, blockOrder);
+
+    return out;
 }
 
 //
@@ -4274,71 +4376,188 @@ void Builder::createConditionalBranch(Id condition, Block* thenBlock, Block* els
 // OpSource
 // [OpSourceContinued]
 // ...
-void Builder::dumpSourceInstructions(const spv::Id fileId, const std::string& text,
-                                     std::vector<unsigned int>& out) const
+// The whole main source text, from sourceText and the pieces that follow it
+std::string Builder::getMainSourceText() const
 {
-    const int maxWordCount = 0xFFFF;
-    const int opSourceWordCount = 4;
-    const int nonNullBytesPerInstruction = 4 * (maxWordCount - opSourceWordCount) - 1;
+    if (sourceTextPieces.empty())
+        return sourceText;
 
+    size_t size = sourceText.size();
+    for (const auto& piece : sourceTextPieces)
+        size += piece.second;
+    std::string text;
+    text.reserve(size);
+    text.append(sourceText);
+    for (const auto& piece : sourceTextPieces)
+        text.append(piece.first, piece.second);
+
+    return text;
+}
+
+// OpSource's source operand is split into instructions of at most this many bytes
+static const size_t maxSourceWordCount = 0xFFFF;
+static const size_t opSourceWordCount = 4;
+static const size_t nonNullSourceBytesPerInstruction = 4 * (maxSourceWordCount - opSourceWordCount) - 1;
+
+size_t Builder::getSourceWordCount(const spv::Id fileId, size_t textSize) const
+{
+    if (sourceLang == SourceLanguageUnknown)
+        return 0;
+    if (fileId == NoResult)
+        return opSourceWordCount - 1;
+    if (textSize == 0)
+        return opSourceWordCount;
+
+    // One OpSource, then an OpSourceContinued for each further full or partial piece
+    const size_t instructions = (textSize - 1) / nonNullSourceBytesPerInstruction + 1;
+    const size_t lastSize = textSize - (instructions - 1) * nonNullSourceBytesPerInstruction;
+
+    return opSourceWordCount + (instructions - 1) +
+           (instructions - 1) * stringWordCount(nonNullSourceBytesPerInstruction) + stringWordCount(lastSize);
+}
+
+size_t Builder::getSourceWordCount() const
+{
+    if (emitNonSemanticShaderDebugInfo)
+        return 0;
+
+    size_t textSize = sourceText.size();
+    for (const auto& piece : sourceTextPieces)
+        textSize += piece.second;
+    size_t wordCount = getSourceWordCount(mainFileId, textSize);
+    for (auto iItr = includeFiles.begin(); iItr != includeFiles.end(); ++iItr)
+        wordCount += getSourceWordCount(iItr->first, iItr->second->size());
+
+    return wordCount;
+}
+
+unsigned int* Builder::dumpSourceInstructions(const spv::Id fileId, const std::string& text,
+                                              const SourcePieces& more, unsigned int* out) const
+{
     if (sourceLang != SourceLanguageUnknown) {
         // OpSource Language Version File Source
-        Instruction sourceInst(NoResult, NoType, OpSource);
-        sourceInst.reserveOperands(3);
-        sourceInst.addImmediateOperand(sourceLang);
-        sourceInst.addImmediateOperand(sourceVersion);
+        unsigned int* sourceInst = out;
+        *out++ = (unsigned int)((opSourceWordCount - 1) << WordCountShift) | OpSource;
+        *out++ = sourceLang;
+        *out++ = sourceVersion;
         // File operand
         if (fileId != NoResult) {
-            sourceInst.addIdOperand(fileId);
-            // Source operand
-            if (text.size() > 0) {
-                int nextByte = 0;
-                std::string subString;
-                while ((int)text.size() - nextByte > 0) {
-                    subString = text.substr(nextByte, nonNullBytesPerInstruction);
-                    if (nextByte == 0) {
-                        // OpSource
-                        sourceInst.addStringOperand(subString.c_str());
-                        sourceInst.dump(out);
-                    } else {
-                        // OpSourcContinued
-                        Instruction sourceContinuedInst(OpSourceContinued);
-                        sourceContinuedInst.addStringOperand(subString.c_str());
-                        sourceContinuedInst.dump(out);
+            *sourceInst = (unsigned int)(opSourceWordCount << WordCountShift) | OpSource;
+            *out++ = fileId;
+            // Source operand, split into instructions of at most nonNullSourceBytesPerInstruction
+            // bytes, each packed straight from as many pieces of the text as it spans
+            size_t textSize = text.size();
+            for (const auto& piece : more)
+                textSize += piece.second;
+            const char* pieceText = text.data();
+            size_t pieceSize = text.size();
+            auto nextPiece = more.cbegin();
+            bool first = true;
+            while (textSize > 0) {
+                const size_t size = std::min(textSize, nonNullSourceBytesPerInstruction);
+                textSize -= size;
+                const unsigned int stringWords = (unsigned int)stringWordCount(size);
+                if (first) {
+                    // OpSource
+                    *sourceInst = (unsigned int)((opSourceWordCount + stringWords) << WordCountShift) | OpSource;
+                } else {
+                    // OpSourcContinued
+                    *out++ = ((1 + stringWords) << WordCountShift) | OpSourceContinued;
+                }
+                unsigned int word = 0;
+                unsigned int shiftAmount = 0;
+                for (size_t left = size; left > 0;) {
+                    while (pieceSize == 0) {
+                        pieceText = nextPiece->first;
+                        pieceSize = nextPiece->second;
+                        ++nextPiece;
                     }
-                    nextByte += nonNullBytesPerInstruction;
+                    const size_t count = std::min(left, pieceSize);
+                    out = packString(pieceText, count, word, shiftAmount, out);
+                    pieceText += count;
+                    pieceSize -= count;
+                    left -= count;
                 }
-            } else
-                sourceInst.dump(out);
-        } else
-            sourceInst.dump(out);
+                *out++ = word;
+                first = false;
+            }
+        }
     }
+
+    return out;
 }
 
 // Dump an OpSource[Continued] sequence for the source and every include file
-void Builder::dumpSourceInstructions(std::vector<unsigned int>& out) const
+unsigned int* Builder::dumpSourceInstructions(unsigned int* out) const
 {
-    if (emitNonSemanticShaderDebugInfo) return;
-    dumpSourceInstructions(mainFileId, sourceText, out);
+    if (emitNonSemanticShaderDebugInfo) return out;
+    static const SourcePieces noPieces;
+    out = dumpSourceInstructions(mainFileId, sourceText, sourceTextPieces, out);
     for (auto iItr = includeFiles.begin(); iItr != includeFiles.end(); ++iItr)
-        dumpSourceInstructions(iItr->first, *iItr->second, out);
+        out = dumpSourceInstructions(iItr->first, *iItr->second, noPieces, out);
+
+    return out;
+}
+
+size_t Builder::getWordCount(const std::vector<std::unique_ptr<Instruction> >& instructions)
+{
+    size_t wordCount = 0;
+    for (int i = 0; i < (int)instructions.size(); ++i)
+        wordCount += instructions[i]->getWordCount();
+
+    return wordCount;
 }
 
-void Builder::dumpInstructions(std::vector<unsigned int>& out,
-    const std::vector<std::unique_ptr<Instruction> >& instructions) const
+unsigned int* Builder::dumpInstructions(unsigned int* out,
+    const std::vector<std::unique_ptr<Instruction> >& instructions)
 {
     for (int i = 0; i < (int)instructions.size(); ++i) {
-        instructions[i]->dump(out);
+        out = instructions[i]->dump(out);
     }
+
+    return out;
 }
 
-void Builder::dumpModuleProcesses(std::vector<unsigned int>& out) const
+size_t Builder::getNamesWordCount() const
 {
-    for (int i = 0; i < (int)moduleProcesses.size(); ++i) {
-        Instruction moduleProcessed(OpModuleProcessed);
-        moduleProcessed.addStringOperand(moduleProcesses[i]);
-        moduleProcessed.dump(out);
+    size_t wordCount = 0;
+    for (const Name& name : names)
+        wordCount += (name.member ? 3 : 2) + stringWordCount(name.string->size());
+
+    return wordCount;
+}
+
+// Dump OpName and OpMemberName, packing their strings the way Instruction::addStringOperand() does
+unsigned int* Builder::dumpNames(unsigned int* out) const
+{
+    for (const Name& name : names) {
+        const std::string& string = *name.string;
+        // the string's words hold its characters and at least one nul
+        const unsigned int stringWords = (unsigned int)stringWordCount(string.size());
+        const unsigned int wordCount = (name.member ? 3 : 2) + stringWords;
+        *out++ = (wordCount << WordCountShift) | (name.member ? OpMemberName : OpName);
+        *out++ = name.id;
+        if (name.member)
+            *out++ = name.memberNumber;
+
+        size_t c = 0;
+        for (unsigned int w = 0; w < stringWords; ++w) {
+            unsigned int word = 0;
+            for (unsigned int shiftAmount = 0; shiftAmount < 32 && c < string.size(); shiftAmount += 8)
+                word |= (unsigned int)(unsigned char)string[c++] << shiftAmount;
+            *out++ = word;
+        }
     }
+
+    return out;
+}
+
+unsigned int* Builder::dumpModuleProcesses(unsigned int* out) const
+{
+    for (int i = 0; i < (int)moduleProcesses.size(); ++i)
+        out = dumpStringInstruction(OpModuleProcessed, moduleProcesses[i], out);
+
+    return out;
 }
 
 } // end spv namespace
@@ -91,17 +91,15 @@ public:
     }
     spv::Id getStringId(const std::string& str)
     {
-        auto sItr = stringIds.find(str);
-        if (sItr != stringIds.end())
-            return sItr->second;
-        spv::Id strId = getUniqueId();
-        Instruction* fileString = new Instruction(strId, NoType, OpString);
-        const char* file_c_str = str.c_str();
-        fileString->addStringOperand(file_c_str);
+        StringPoolEntry& entry = internString(str);
+        if (entry.second != NoResult)
+            return entry.second;
+        entry.second = getUniqueId();
+        Instruction* fileString = new Instruction(entry.second, NoType, OpString);
+        fileString->addStringOperand(entry.first.c_str());
         strings.push_back(std::unique_ptr<Instruction>(fileString));
         module.mapInstruction(fileString);
-        stringIds[file_c_str] = strId;
-        return strId;
+        return entry.second;
     }
 
     spv::Id getMainFileId() const { return mainFileId; }
@@ -133,7 +131,9 @@ public:
         }
     }
 
-    void setSourceText(const std::string& text) { sourceText = text; }
+    void setSourceText(const std::string& text) { sourceText = text; sourceTextPieces.clear(); }
+    // Append to the source text without copying; like included text, it must outlive the builder's dump().
+    void addSourceText(const char* text, size_t length) { sourceTextPieces.emplace_back(text, length); }
     void addSourceExtension(const char* ext) { sourceExtensions.push_back(ext); }
     void addModuleProcessed(const std::string& p) { moduleProcesses.push_back(p.c_str()); }
     void setEmitSpirvDebugInfo()
@@ -859,7 +859,13 @@ public:
     // move OpSampledImage instructions to be next to their users.
     void postProcessSamplers();
 
+    // Size in words of the module dump() writes.
+    size_t getWordCount() const;
+    // Appends the module to the vector, growing it once.
     void dump(std::vector<unsigned int>&) const;
+    // Writes the module to 'words', which has room for 'capacity' words; returns the number of
+    // words written, or 0 without writing anything if the module needs more than 'capacity'.
+    size_t dump(unsigned int* words, size_t capacity) const;
 
     void createBranch(Block* block);
     void createConditionalBranch(Id condition, Block* thenBlock, Block* elseBlock);
@@ -875,6 +881,11 @@ public:
 
     void setUseReplicatedComposites(bool use) { useReplicatedComposites = use; }
 
+    // Cached types and constants compared while making new ones; only counted when built
+    // with ENABLE_COUNTERS.
+    unsigned long long getTypeProbes() const { return typeProbes; }
+    unsigned long long getConstantProbes() const { return constantProbes; }
+
  protected:
     Id makeIntConstant(Id typeId, unsigned value, bool specConstant);
     Id makeInt64Constant(Id typeId, unsigned long long value, bool specConstant);
@@ -888,10 +899,32 @@ public:
     void simplifyAccessChainSwizzle();
     void createAndSetNoPredecessorBlock(const char*);
     void createSelectionMerge(Block* mergeBlock, unsigned int control);
-    void dumpSourceInstructions(std::vector<unsigned int>&) const;
-    void dumpSourceInstructions(const spv::Id fileId, const std::string& text, std::vector<unsigned int>&) const;
-    void dumpInstructions(std::vector<unsigned int>&, const std::vector<std::unique_ptr<Instruction> >&) const;
-    void dumpModuleProcesses(std::vector<unsigned int>&) const;
+    // Sizing walks each function's CFG once; dumping replays the 'blockOrder' it recorded.
+    size_t getWordCount(std::vector<const Block*>& blockOrder) const;
+    unsigned int* dump(unsigned int* out, const std::vector<const Block*>& blockOrder) const;
+    size_t getSourceWordCount() const;
+    size_t getSourceWordCount(const spv::Id fileId, size_t textSize) const;
+    unsigned int* dumpSourceInstructions(unsigned int*) const;
+    typedef std::vector<std::pair<const char*, size_t>> SourcePieces;
+    unsigned int* dumpSourceInstructions(const spv::Id fileId, const std::string& text, const SourcePieces& more,
+                                         unsigned int*) const;
+    std::string getMainSourceText() const;
+    static size_t getWordCount(const std::vector<std::unique_ptr<Instruction> >&);
+    static unsigned int* dumpInstructions(unsigned int*, const std::vector<std::unique_ptr<Instruction> >&);
+    unsigned int* dumpModuleProcesses(unsigned int*) const;
+    size_t getNamesWordCount() const;
+    unsigned int* dumpNames(unsigned int*) const;
+
+    // Strings are interned once per module; the key is the string, and the value the id of
+    // its OpString, or NoResult if it has none.
+    typedef std::pair<const std::string, spv::Id> StringPoolEntry;
+    StringPoolEntry& internString(const std::string& str)
+    {
+        auto sItr = stringIds.find(str);
+        if (sItr == stringIds.end())
+            sItr = stringIds.emplace(str, NoResult).first;
+        return *sItr;
+    }
     spv::MemoryAccessMask sanitizeMemoryAccessForStorageClass(spv::MemoryAccessMask memoryAccess, StorageClass sc)
         const;
 
@@ -903,6 +936,7 @@ public:
     spv::Id debugInfoNone {0};
     spv::Id debugExpression {0}; // Debug expression with zero operations.
     std::string sourceText;
+    std::vector<std::pair<const char*, size_t>> sourceTextPieces;  // follow sourceText
 
     // True if an new OpLine/OpDebugLine may need to be inserted. Either:
     // 1. The current debug location changed
@@ -949,7 +983,14 @@ public:
     std::vector<std::unique_ptr<Instruction> > imports;
     std::vector<std::unique_ptr<Instruction> > entryPoints;
     std::vector<std::unique_ptr<Instruction> > executionModes;
-    std::vector<std::unique_ptr<Instruction> > names;
+    // OpName and OpMemberName, packed to words only when dumped
+    struct Name {
+        Id id;
+        bool member;
+        unsigned int memberNumber;
+        const std::string* string;  // in stringIds
+    };
+    std::vector<Name> names;
     std::vector<std::unique_ptr<Instruction> > decorations;
     std::vector<std::unique_ptr<Instruction> > constantsTypesGlobals;
     std::vector<std::unique_ptr<Instruction> > externals;
@@ -974,7 +1015,7 @@ public:
     // Our loop stack.
     std::stack<LoopBlocks> loops;
 
-    // map from strings to their string ids
+    // pool of strings, mapped to their string ids; see internString()
     std::unordered_map<std::string, spv::Id> stringIds;
 
     // map from include file name ids to their contents
@@ -988,6 +1029,21 @@ public:
 
     // The stream for outputting warnings and errors.
     SpvBuildLogger* logger;
+
+    void countTypeProbe()
+    {
+#ifdef ENABLE_COUNTERS
+        ++typeProbes;
+#endif
+    }
+    void countConstantProbe()
+    {
+#ifdef ENABLE_COUNTERS
+        ++constantProbes;
+#endif
+    }
+    unsigned long long typeProbes = 0;
+    unsigned long long constantProbes = 0;
 };  // end Builder class
 
 };  // end spv namespace
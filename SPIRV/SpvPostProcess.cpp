@@ -339,6 +339,12 @@ void Builder::postProcess(Instruction& inst)
 // comment in header
 void Builder::postProcessCFG()
 {
+    // Without branches, every block is its function's reachable entry block: there is
+    // nothing to prune, which is the common case of small shaders.
+    if (std::all_of(module.getFunctions().cbegin(), module.getFunctions().cend(),
+                    [](const Function* f) { return f->getBlocks().size() == 1; }))
+        return;
+
     // reachableBlocks is the set of blockss reached via control flow, or which are
     // unreachable continue targert or unreachable merge.
     std::unordered_set<const Block*> reachableBlocks;
@@ -43,6 +43,7 @@
 
 #include "doc.h"
 
+#include <cassert>
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
@@ -1598,6 +1599,32 @@ const char* OpcodeString(int op)
     }
 }
 
+std::vector<OperandDescription> OperandParameters::storage;
+
+// Every operand Parameterize() stores, with the runs push() moves, so 'storage' is
+// allocated once and never moves; raise it when adding operands.
+static const size_t OperandStorageSize = 1217;
+
+void OperandParameters::push(OperandClass oc, const char* d, bool opt)
+{
+    if (storage.capacity() == 0)
+        storage.reserve(OperandStorageSize);
+
+    // keep the set contiguous: start a new run, or move this one to the end
+    // if another set was pushed to since
+    if (count == 0)
+        first = (int)storage.size();
+    else if (first + count != (int)storage.size()) {
+        const int moved = (int)storage.size();
+        for (int op = 0; op < count; ++op)
+            storage.push_back(storage[first + op]);
+        first = moved;
+    }
+    storage.push_back({oc, d, opt});
+    ++count;
+    assert(storage.size() <= OperandStorageSize);
+}
+
 // The set of objects that hold all the instruction/operand
 // parameterization information.
 InstructionParameters InstructionDesc[OpCodeMask + 1];
@@ -166,39 +166,43 @@ enum OperandClass {
 // Any specific enum can have a set of capabilities that allow it:
 typedef std::vector<Capability> EnumCaps;
 
+// One operand of an instruction, execution mode, or decoration.
+struct OperandDescription {
+    OperandClass opClass;
+    const char* desc;
+    bool optional;
+};
+
 // Parameterize a set of operands with their OperandClass(es) and descriptions.
+// The operands of all sets live one after another in the flat 'storage', each
+// set referring to its own run of it, so the tables need no per-set allocation
+// and start out as zero-initialized statics.
 class OperandParameters {
 public:
-    OperandParameters() { }
-    void push(OperandClass oc, const char* d, bool opt = false)
-    {
-        opClass.push_back(oc);
-        desc.push_back(d);
-        optional.push_back(opt);
-    }
-    void setOptional();
-    OperandClass getClass(int op) const { return opClass[op]; }
-    const char* getDesc(int op) const { return desc[op]; }
-    bool isOptional(int op) const { return optional[op]; }
-    int getNum() const { return (int)opClass.size(); }
+    constexpr OperandParameters() : first(0), count(0) { }
+    void push(OperandClass oc, const char* d, bool opt = false);
+    OperandClass getClass(int op) const { return storage[first + op].opClass; }
+    const char* getDesc(int op) const { return storage[first + op].desc; }
+    bool isOptional(int op) const { return storage[first + op].optional; }
+    int getNum() const { return count; }
 
 protected:
-    std::vector<OperandClass> opClass;
-    std::vector<const char*> desc;
-    std::vector<bool> optional;
+    static std::vector<OperandDescription> storage;
+    int first;
+    int count;
 };
 
 // Parameterize an enumerant
 class EnumParameters {
 public:
-    EnumParameters() : desc(nullptr) { }
+    constexpr EnumParameters() : desc(nullptr) { }
     const char* desc;
 };
 
 // Parameterize a set of enumerants that form an enum
 class EnumDefinition : public EnumParameters {
 public:
-    EnumDefinition() :
+    constexpr EnumDefinition() :
         ceiling(0), bitmask(false), getName(nullptr), enumParams(nullptr), operandParams(nullptr) { }
     void set(int ceil, const char* (*name)(int), EnumParameters* ep, bool mask = false)
     {
@@ -219,29 +223,23 @@ public:
 // per OperandParameters above.
 class InstructionParameters {
 public:
-    InstructionParameters() :
-        opDesc("TBD"),
-        opClass(OpClassMissing),
-        typePresent(true),         // most normal, only exceptions have to be spelled out
-        resultPresent(true)        // most normal, only exceptions have to be spelled out
-    { }
+    // most instructions have both, only exceptions have to be spelled out
+    constexpr InstructionParameters() : typeAbsent(false), resultAbsent(false) { }
 
     void setResultAndType(bool r, bool t)
     {
-        resultPresent = r;
-        typePresent = t;
+        resultAbsent = !r;
+        typeAbsent = !t;
     }
 
-    bool hasResult() const { return resultPresent != 0; }
-    bool hasType()   const { return typePresent != 0; }
+    bool hasResult() const { return resultAbsent == 0; }
+    bool hasType()   const { return typeAbsent == 0; }
 
-    const char* opDesc;
-    OpcodeClass opClass;
     OperandParameters operands;
 
 protected:
-    bool typePresent   : 1;
-    bool resultPresent : 1;
+    bool typeAbsent   : 1;
+    bool resultAbsent : 1;
 };
 
 // The set of objects that hold all the instruction/operand
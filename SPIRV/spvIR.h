@@ -51,6 +51,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -167,9 +168,8 @@ public:
     }
 
     // Write out the binary form.
-    void dump(std::vector<unsigned int>& out) const
+    unsigned int getWordCount() const
     {
-        // Compute the wordCount
         unsigned int wordCount = 1;
         if (typeId)
             ++wordCount;
@@ -177,16 +177,33 @@ public:
             ++wordCount;
         wordCount += (unsigned int)operands.size();
 
+        return wordCount;
+    }
+
+    // Writes getWordCount() words at 'out', returning the end of what was written.
+    unsigned int* dump(unsigned int* out) const
+    {
         // Write out the beginning of the instruction
-        out.push_back(((wordCount) << WordCountShift) | opCode);
+        *out++ = (getWordCount() << WordCountShift) | opCode;
         if (typeId)
-            out.push_back(typeId);
+            *out++ = typeId;
         if (resultId)
-            out.push_back(resultId);
+            *out++ = resultId;
 
         // Write out the operands
-        for (int op = 0; op < (int)operands.size(); ++op)
-            out.push_back(operands[op]);
+        if (! operands.empty()) {
+            memcpy(out, operands.data(), operands.size() * sizeof(Id));
+            out += operands.size();
+        }
+
+        return out;
+    }
+
+    void dump(std::vector<unsigned int>& out) const
+    {
+        const size_t start = out.size();
+        out.resize(start + getWordCount());
+        dump(out.data() + start);
     }
 
 protected:
@@ -312,13 +329,26 @@ public:
         }
     }
 
-    void dump(std::vector<unsigned int>& out) const
+    size_t getWordCount() const
+    {
+        size_t wordCount = 0;
+        for (int i = 0; i < (int)localVariables.size(); ++i)
+            wordCount += localVariables[i]->getWordCount();
+        for (int i = 0; i < (int)instructions.size(); ++i)
+            wordCount += instructions[i]->getWordCount();
+
+        return wordCount;
+    }
+
+    unsigned int* dump(unsigned int* out) const
     {
-        instructions[0]->dump(out);
+        out = instructions[0]->dump(out);
         for (int i = 0; i < (int)localVariables.size(); ++i)
-            localVariables[i]->dump(out);
+            out = localVariables[i]->dump(out);
         for (int i = 1; i < (int)instructions.size(); ++i)
-            instructions[i]->dump(out);
+            out = instructions[i]->dump(out);
+
+        return out;
     }
 
 protected:
@@ -431,24 +461,50 @@ public:
             DecorationRelaxedPrecision : NoPrecision;
     }
 
-    void dump(std::vector<unsigned int>& out) const
+    // Appends the blocks dump() writes, in the order it writes them, then a null, and returns
+    // the word count; dump() replays this order rather than walking the CFG a second time.
+    size_t getWordCount(std::vector<const Block*>& blockOrder) const
+    {
+        size_t wordCount = 0;
+        if (lineInstruction != nullptr)
+            wordCount += lineInstruction->getWordCount();
+        wordCount += functionInstruction.getWordCount();
+        for (int p = 0; p < (int)parameterInstructions.size(); ++p)
+            wordCount += parameterInstructions[p]->getWordCount();
+        inReadableOrder(blocks[0], [&wordCount, &blockOrder](const Block* b, ReachReason, Block*) {
+            wordCount += b->getWordCount();
+            blockOrder.push_back(b);
+        });
+        blockOrder.push_back(nullptr);
+        wordCount += 1;  // OpFunctionEnd
+
+        return wordCount;
+    }
+
+    // Writes the blocks from 'block' up to the null getWordCount() ended them with, leaving
+    // 'block' at the next function's blocks.
+    unsigned int* dump(unsigned int* out, const Block* const*& block) const
     {
         // OpLine
         if (lineInstruction != nullptr) {
-            lineInstruction->dump(out);
+            out = lineInstruction->dump(out);
         }
 
         // OpFunction
-        functionInstruction.dump(out);
+        out = functionInstruction.dump(out);
 
         // OpFunctionParameter
         for (int p = 0; p < (int)parameterInstructions.size(); ++p)
-            parameterInstructions[p]->dump(out);
+            out = parameterInstructions[p]->dump(out);
 
         // Blocks
-        inReadableOrder(blocks[0], [&out](const Block* b, ReachReason, Block*) { b->dump(out); });
+        for (; *block != nullptr; ++block)
+            out = (*block)->dump(out);
+        ++block;
         Instruction end(0, 0, OpFunctionEnd);
-        end.dump(out);
+        out = end.dump(out);
+
+        return out;
     }
 
     LinkageType getLinkType() const { return linkType; }
@@ -504,10 +560,30 @@ public:
         return (StorageClass)idToInstruction[typeId]->getImmediateOperand(0);
     }
 
-    void dump(std::vector<unsigned int>& out) const
+    // Appends each function's blocks to 'blockOrder' in the order dump() writes them, having
+    // made room for all of them, and each function's null, up front.
+    size_t getWordCount(std::vector<const Block*>& blockOrder) const
     {
+        size_t blockCount = blockOrder.size();
         for (int f = 0; f < (int)functions.size(); ++f)
-            functions[f]->dump(out);
+            blockCount += functions[f]->getBlocks().size() + 1;
+        blockOrder.reserve(blockCount);
+
+        size_t wordCount = 0;
+        for (int f = 0; f < (int)functions.size(); ++f)
+            wordCount += functions[f]->getWordCount(blockOrder);
+
+        return wordCount;
+    }
+
+    // Writes the functions, with their blocks in the 'blockOrder' getWordCount() produced.
+    unsigned int* dump(unsigned int* out, const std::vector<const Block*>& blockOrder) const
+    {
+        const Block* const* block = blockOrder.data();
+        for (int f = 0; f < (int)functions.size(); ++f)
+            out = functions[f]->dump(out, block);
+
+        return out;
     }
 
 protected:
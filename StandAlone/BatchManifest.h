@@ -0,0 +1,447 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//
+// Support for the standalone compiler's --batch mode: reading the job manifest,
+// sharing include files between jobs, and writing the summary.
+//
+// A manifest is a JSON array of jobs, or an object with a "jobs" array:
+//
+//   { "jobs": [ { "inputs": [ "a.vert", "a.frag" ],
+//                 "stage": "frag",
+//                 "defines": [ "QUALITY=2", "SHADOWS" ],
+//                 "target-env": "vulkan1.2",
+//                 "entry-point": "main",
+//                 "output": "a.spv" } ] }
+//
+// Only "inputs" is required.  Everything not given by a job comes from the
+// command line, which applies to every job in the manifest.
+//
+
+#ifndef BATCH_MANIFEST_H_INCLUDED
+#define BATCH_MANIFEST_H_INCLUDED
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DirStackFileIncluder.h"
+
+namespace glslang {
+
+    // One compile/link job from a batch manifest, and what became of it.
+    class TBatchJob {
+    public:
+        TBatchJob() : compileFailed(false), linkFailed(false), outputFailed(false), milliseconds(0.0) { }
+
+        // From the manifest
+        std::vector<std::string> inputs;
+        std::string stage;
+        std::vector<std::string> defines;
+        std::string targetEnv;
+        std::string entryPoint;
+        std::string output;
+
+        // Results
+        bool compileFailed;
+        bool linkFailed;
+        bool outputFailed;
+        std::vector<std::string> outputs;
+        std::string log;
+        double milliseconds;
+
+        bool succeeded() const { return !compileFailed && !linkFailed && !outputFailed; }
+    };
+
+    //
+    // Reads the small subset of JSON a manifest needs: objects, arrays, and strings.
+    // Anything else is reported as an error, with the line it was found on.
+    //
+    class TBatchManifestReader {
+    public:
+        explicit TBatchManifestReader(const std::string& text) : text(text), pos(0) { }
+
+        // Returns false, with a message in 'error', if the manifest is malformed.
+        bool read(std::vector<TBatchJob>& jobs, std::string& error)
+        {
+            skipSpace();
+            if (peek() == '{') {
+                ++pos;
+                bool sawJobs = false;
+                if (!accept('}')) {
+                    do {
+                        std::string key;
+                        if (!readString(key) || !expect(':'))
+                            return fail(error);
+                        if (key != "jobs") {
+                            message = "unknown manifest key '" + key + "'";
+                            return fail(error);
+                        }
+                        if (!readJobs(jobs))
+                            return fail(error);
+                        sawJobs = true;
+                    } while (accept(','));
+                    if (!expect('}'))
+                        return fail(error);
+                }
+                if (!sawJobs) {
+                    message = "manifest has no 'jobs' array";
+                    return fail(error);
+                }
+            } else if (!readJobs(jobs))
+                return fail(error);
+
+            skipSpace();
+            if (pos != text.size()) {
+                message = "unexpected text after manifest";
+                return fail(error);
+            }
+
+            return true;
+        }
+
+    protected:
+        const std::string& text;
+        size_t pos;
+        std::string message;
+
+        bool fail(std::string& error)
+        {
+            // report a 1-based line number, as compilers do
+            int line = 1;
+            for (size_t c = 0; c < pos && c < text.size(); ++c) {
+                if (text[c] == '\n')
+                    ++line;
+            }
+            std::ostringstream out;
+            out << "line " << line << ": " << (message.empty() ? "malformed manifest" : message);
+            error = out.str();
+            return false;
+        }
+
+        void skipSpace()
+        {
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+                ++pos;
+        }
+
+        char peek()
+        {
+            skipSpace();
+            return pos < text.size() ? text[pos] : 0;
+        }
+
+        bool accept(char c)
+        {
+            if (peek() != c)
+                return false;
+            ++pos;
+            return true;
+        }
+
+        bool expect(char c)
+        {
+            if (accept(c))
+                return true;
+            message = std::string("expected '") + c + "'";
+            return false;
+        }
+
+        bool readString(std::string& str)
+        {
+            if (peek() != '"') {
+                message = "expected a string";
+                return false;
+            }
+            ++pos;
+            str.clear();
+            while (pos < text.size() && text[pos] != '"') {
+                char c = text[pos++];
+                if (c != '\\') {
+                    str.push_back(c);
+                    continue;
+                }
+                if (pos >= text.size())
+                    break;
+                c = text[pos++];
+                switch (c) {
+                case '"':
+                case '\\':
+                case '/': str.push_back(c);    break;
+                case 'b': str.push_back('\b'); break;
+                case 'f': str.push_back('\f'); break;
+                case 'n': str.push_back('\n'); break;
+                case 'r': str.push_back('\r'); break;
+                case 't': str.push_back('\t'); break;
+                case 'u':
+                    {
+                        if (pos + 4 > text.size()) {
+                            message = "truncated \\u escape";
+                            return false;
+                        }
+                        unsigned int code = 0;
+                        for (int digit = 0; digit < 4; ++digit) {
+                            const char h = text[pos++];
+                            code <<= 4;
+                            if (h >= '0' && h <= '9')
+                                code |= (unsigned int)(h - '0');
+                            else if (h >= 'a' && h <= 'f')
+                                code |= (unsigned int)(h - 'a' + 10);
+                            else if (h >= 'A' && h <= 'F')
+                                code |= (unsigned int)(h - 'A' + 10);
+                            else {
+                                message = "bad \\u escape";
+                                return false;
+                            }
+                        }
+                        // encode as UTF-8; surrogate pairs are not needed for file names and macros
+                        if (code < 0x80)
+                            str.push_back((char)code);
+                        else if (code < 0x800) {
+                            str.push_back((char)(0xC0 | (code >> 6)));
+                            str.push_back((char)(0x80 | (code & 0x3F)));
+                        } else {
+                            str.push_back((char)(0xE0 | (code >> 12)));
+                            str.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+                            str.push_back((char)(0x80 | (code & 0x3F)));
+                        }
+                    }
+                    break;
+                default:
+                    message = std::string("unknown escape '\\") + c + "'";
+                    return false;
+                }
+            }
+            if (pos >= text.size()) {
+                message = "unterminated string";
+                return false;
+            }
+            ++pos;
+
+            return true;
+        }
+
+        bool readStringList(std::vector<std::string>& list)
+        {
+            if (peek() == '"') {
+                list.emplace_back();
+                return readString(list.back());
+            }
+            if (!expect('['))
+                return false;
+            if (accept(']'))
+                return true;
+            do {
+                list.emplace_back();
+                if (!readString(list.back()))
+                    return false;
+            } while (accept(','));
+
+            return expect(']');
+        }
+
+        bool readJob(TBatchJob& job)
+        {
+            if (!expect('{'))
+                return false;
+            if (!accept('}')) {
+                do {
+                    std::string key;
+                    if (!readString(key) || !expect(':'))
+                        return false;
+                    bool ok;
+                    if (key == "inputs" || key == "input")
+                        ok = readStringList(job.inputs);
+                    else if (key == "defines")
+                        ok = readStringList(job.defines);
+                    else if (key == "stage")
+                        ok = readString(job.stage);
+                    else if (key == "target-env")
+                        ok = readString(job.targetEnv);
+                    else if (key == "entry-point")
+                        ok = readString(job.entryPoint);
+                    else if (key == "output")
+                        ok = readString(job.output);
+                    else {
+                        message = "unknown job key '" + key + "'";
+                        return false;
+                    }
+                    if (!ok)
+                        return false;
+                } while (accept(','));
+                if (!expect('}'))
+                    return false;
+            }
+            if (job.inputs.empty()) {
+                message = "job has no inputs";
+                return false;
+            }
+
+            return true;
+        }
+
+        bool readJobs(std::vector<TBatchJob>& jobs)
+        {
+            if (!expect('['))
+                return false;
+            if (accept(']'))
+                return true;
+            do {
+                jobs.emplace_back();
+                if (!readJob(jobs.back()))
+                    return false;
+            } while (accept(','));
+
+            return expect(']');
+        }
+    };
+
+    //
+    // Contents of every file read by any job of a batch, keyed by the path it was
+    // found at.  Misses are remembered too, so the include search of later jobs does
+    // not touch the file system at all.  Safe to use from all worker threads.
+    //
+    class TIncludeCache {
+    public:
+        TIncludeCache() { }
+
+        // Returns nullptr if there is no readable file at 'path'.
+        const std::string* read(const std::string& path)
+        {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                auto it = files.find(path);
+                if (it != files.end())
+                    return it->second.get();
+            }
+
+            // read outside the lock; if two threads race, the first insertion wins
+            std::unique_ptr<std::string> contents;
+            std::ifstream file(path, std::ios_base::binary);
+            if (file) {
+                std::ostringstream buffer;
+                buffer << file.rdbuf();
+                contents.reset(new std::string(buffer.str()));
+            }
+
+            std::lock_guard<std::mutex> guard(mutex);
+            return files.emplace(path, std::move(contents)).first->second.get();
+        }
+
+        // Contents at 'path' that do not come from the file system.
+        void add(const std::string& path, const std::string& contents)
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            files[path].reset(new std::string(contents));
+        }
+
+    protected:
+        TIncludeCache(const TIncludeCache&);
+        TIncludeCache& operator=(const TIncludeCache&);
+
+        std::mutex mutex;
+        std::unordered_map<std::string, std::unique_ptr<std::string>> files;
+    };
+
+    // The normal directory-stack search, reading through a cache shared by all jobs.
+    class TCachedFileIncluder : public DirStackFileIncluder {
+    public:
+        explicit TCachedFileIncluder(TIncludeCache& cache) : cache(cache) { }
+
+        virtual void releaseInclude(IncludeResult* result) override
+        {
+            // the text belongs to the cache
+            delete result;
+        }
+
+    protected:
+        TIncludeCache& cache;
+
+        virtual IncludeResult* readLocalPath(const char* headerName, const char* includerName, int depth) override
+        {
+            directoryStack.resize(depth + externalLocalDirectoryCount);
+            if (depth == 1)
+                directoryStack.back() = getDirectory(includerName);
+
+            for (auto it = directoryStack.rbegin(); it != directoryStack.rend(); ++it) {
+                std::string path = *it + '/' + headerName;
+                std::replace(path.begin(), path.end(), '\\', '/');
+                const std::string* contents = cache.read(path);
+                if (contents != nullptr) {
+                    directoryStack.push_back(getDirectory(path));
+                    includedFiles.insert(path);
+                    return new IncludeResult(path, contents->data(), contents->size(), nullptr);
+                }
+            }
+
+            return nullptr;
+        }
+    };
+
+    // Quote a string for the JSON summary.
+    inline std::string JsonQuote(const std::string& str)
+    {
+        std::string quoted("\"");
+        for (char c : str) {
+            switch (c) {
+            case '"':  quoted.append("\\\""); break;
+            case '\\': quoted.append("\\\\"); break;
+            case '\n': quoted.append("\\n");  break;
+            case '\r': quoted.append("\\r");  break;
+            case '\t': quoted.append("\\t");  break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char escape[8];
+                    snprintf(escape, sizeof(escape), "\\u%04x", (unsigned int)(unsigned char)c);
+                    quoted.append(escape);
+                } else
+                    quoted.push_back(c);
+                break;
+            }
+        }
+        quoted.push_back('"');
+
+        return quoted;
+    }
+
+} // end namespace glslang
+
+#endif // BATCH_MANIFEST_H_INCLUDED
@@ -44,25 +44,35 @@
 #include "glslang/Public/ResourceLimits.h"
 #include "Worklist.h"
 #include "DirStackFileIncluder.h"
+#include "BatchManifest.h"
 #include "./../glslang/Include/ShHandle.h"
 #include "./../glslang/Public/ShaderLang.h"
+#include "./../glslang/Public/ReflectionBinary.h"
+#include "./../glslang/Public/CompileWorker.h"
 #include "../glslang/MachineIndependent/localintermediate.h"
 #include "../SPIRV/GlslangToSpv.h"
 #include "../SPIRV/GLSL.std.450.h"
 #include "../SPIRV/doc.h"
 #include "../SPIRV/disassemble.h"
+#include "../SPIRV/SpvTools.h"
 
 #include <array>
 #include <atomic>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <map>
 #include <memory>
 #include <set>
 #include <thread>
 
+#ifndef _WIN32
+    #include <csignal>
+#endif
+
 #include "../glslang/OSDependent/osinclude.h"
 
 // Build-time generated includes
@@ -114,6 +124,10 @@ enum TOptions : uint64_t {
 bool targetHlslFunctionality1 = false;
 bool SpvToolsDisassembler = false;
 bool SpvToolsValidate = false;
+bool SpvToolsValidateConcurrent = false;
+bool SpvParallelStages = false;
+bool PrintFingerprint = false;
+bool PrintCounters = false;
 bool NaNClamp = false;
 bool stripDebugInfo = false;
 bool emitNonSemanticShaderDebugInfo = false;
@@ -139,6 +153,8 @@ enum TFailCode {
 // Forward declarations.
 //
 EShLanguage FindLanguage(const std::string& name, bool parseSuffix=true);
+bool DeduceLanguage(const std::string& name, const char* stageOverride, bool parseStageName,
+                    EShLanguage& language, bool& isHlsl);
 void CompileFile(const char* fileName, ShHandle);
 void usage();
 char* ReadFileData(const char* fileName);
@@ -185,6 +201,12 @@ bool EnhancedMsgs = false;
 bool AbsolutePath = false;
 bool DumpBuiltinSymbols = false;
 std::vector<std::string> IncludeDirectoryList;
+const char* batchManifestName = nullptr;
+const char* batchSummaryName = nullptr;
+unsigned int batchThreads = 0;  // 0: one per hardware thread
+const char* workerSocketName = nullptr;
+const char* reflectBinaryName = nullptr;
+const char* dumpReflectBinaryName = nullptr;
 
 // Source environment
 // (source 'Client' is currently the same as target 'Client')
@@ -225,7 +247,8 @@ unsigned int atomicCounterBlockSet;
 // Add things like "#define ..." to a preamble to use in the beginning of the shader.
 class TPreamble {
 public:
-    TPreamble() { }
+    TPreamble() : processes(Processes) { }
+    explicit TPreamble(std::vector<std::string>& processes) : processes(processes) { }
 
     bool isSet() const { return text.size() > 0; }
     const char* get() const { return text.c_str(); }
@@ -236,8 +259,8 @@ public:
         text.append("#define ");
         fixLine(def);
 
-        Processes.push_back("define-macro ");
-        Processes.back().append(def);
+        processes.push_back("define-macro ");
+        processes.back().append(def);
 
         // The first "=" needs to turn into a space
         const size_t equal = def.find_first_of("=");
@@ -254,8 +277,8 @@ public:
         text.append("#undef ");
         fixLine(undef);
 
-        Processes.push_back("undef-macro ");
-        Processes.back().append(undef);
+        processes.push_back("undef-macro ");
+        processes.back().append(undef);
 
         text.append(undef);
         text.append("\n");
@@ -265,8 +288,8 @@ public:
     {
         fixLine(preambleText);
 
-        Processes.push_back("preamble-text");
-        Processes.back().append(preambleText);
+        processes.push_back("preamble-text");
+        processes.back().append(preambleText);
 
         text.append(preambleText);
         text.append("\n");
@@ -281,6 +304,7 @@ protected:
             line = line.substr(0, end);
     }
 
+    std::vector<std::string>& processes;  // where to record each addition
     std::string text;  // contents of preamble
 };
 
@@ -643,6 +667,26 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                         uniformBase = static_cast<int>(::strtol(argv[1], nullptr, 10));
                         bumpArg();
                         break;
+                    } else if (lowerword == "batch") {
+                        if (argc <= 1)
+                            Error("no <manifest> provided", lowerword.c_str());
+                        batchManifestName = argv[1];
+                        bumpArg();
+                    } else if (lowerword == "batch-summary") {
+                        if (argc <= 1)
+                            Error("no <file> provided", lowerword.c_str());
+                        batchSummaryName = argv[1];
+                        bumpArg();
+                    } else if (lowerword == "batch-threads") {
+                        if (argc <= 1)
+                            Error("no <count> provided", lowerword.c_str());
+                        batchThreads = static_cast<unsigned int>(::strtoul(argv[1], nullptr, 10));
+                        bumpArg();
+                    } else if (lowerword == "worker") {
+                        if (argc <= 1)
+                            Error("no <socket> provided", lowerword.c_str());
+                        workerSocketName = argv[1];
+                        bumpArg();
                     } else if (lowerword == "client") {
                         if (argc > 1) {
                             if (strcmp(argv[1], "vulkan100") == 0)
@@ -654,6 +698,8 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                         } else
                             Error("expects vulkan100 or opengl100", lowerword.c_str());
                         bumpArg();
+                    } else if (lowerword == "counters") {
+                        PrintCounters = true;
                     } else if (lowerword == "define-macro" ||
                                lowerword == "d") {
                         if (argc > 1)
@@ -663,11 +709,18 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                         bumpArg();
                     } else if (lowerword == "dump-builtin-symbols") {
                         DumpBuiltinSymbols = true;
+                    } else if (lowerword == "dump-reflect-binary") {
+                        if (argc <= 1)
+                            Error("no <file> provided", lowerword.c_str());
+                        dumpReflectBinaryName = argv[1];
+                        bumpArg();
                     } else if (lowerword == "entry-point") {
                         entryPointName = argv[1];
                         if (argc <= 1)
                             Error("no <name> provided", lowerword.c_str());
                         bumpArg();
+                    } else if (lowerword == "fingerprint") {
+                        PrintFingerprint = true;
                     } else if (lowerword == "flatten-uniform-arrays" || // synonyms
                                lowerword == "flatten-uniform-array"  ||
                                lowerword == "fua") {
@@ -770,6 +823,13 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                         ReflectOptions |= EShReflectionSharedStd140UBO;
                     } else if (lowerword == "reflect-shared-std140-ssbo") {
                         ReflectOptions |= EShReflectionSharedStd140SSBO;
+                    } else if (lowerword == "reflect-parallel-stages") {
+                        ReflectOptions |= EShReflectionParallelStages;
+                    } else if (lowerword == "reflect-binary") {
+                        if (argc <= 1)
+                            Error("no <file> provided", lowerword.c_str());
+                        reflectBinaryName = argv[1];
+                        bumpArg();
                     } else if (lowerword == "resource-set-bindings" ||  // synonyms
                                lowerword == "resource-set-binding"  ||
                                lowerword == "rsb") {
@@ -823,6 +883,10 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                         SpvToolsDisassembler = true;
                     } else if (lowerword == "spirv-val") {
                         SpvToolsValidate = true;
+                    } else if (lowerword == "spirv-val-concurrent") {
+                        SpvToolsValidateConcurrent = true;
+                    } else if (lowerword == "spirv-parallel-stages") {
+                        SpvParallelStages = true;
                     } else if (lowerword == "stdin") {
                         Options |= EOptionStdin;
                         shaderStageName = argv[1];
@@ -1065,6 +1129,49 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
         }
     }
 
+    // Batch jobs bring their own inputs and outputs, and report through the summary
+    if (batchManifestName) {
+        if (! workItems.empty() || (Options & EOptionStdin))
+            Error("input files cannot be given with --batch; list them in the manifest");
+        if (binaryFileName || depencyFileName)
+            Error("-o and --depfile cannot be used with --batch; use the manifest's \"output\"");
+        if (Options & (EOptionOutputPreprocessed | EOptionDumpReflection | EOptionIntermediate | EOptionMemoryLeakMode))
+            Error("-E, -q, -i, and -m cannot be used with --batch");
+        if (reflectBinaryName)
+            Error("--reflect-binary cannot be used with --batch");
+        if (PrintFingerprint)
+            Error("--fingerprint cannot be used with --batch");
+        if (PrintCounters)
+            Error("--counters cannot be used with --batch");
+    } else if (batchSummaryName || batchThreads)
+        Error("--batch-summary and --batch-threads require --batch");
+
+    // Worker jobs come from clients, and their results go back to them
+    if (workerSocketName) {
+#ifdef _WIN32
+        Error("--worker is not supported on Windows");
+#endif
+        if (batchManifestName)
+            Error("--worker cannot be used with --batch");
+        if (! workItems.empty() || (Options & EOptionStdin))
+            Error("input files cannot be given with --worker; clients send them with each job");
+        if (binaryFileName || depencyFileName)
+            Error("-o and --depfile cannot be used with --worker");
+        if (Options & (EOptionOutputPreprocessed | EOptionDumpReflection | EOptionIntermediate | EOptionMemoryLeakMode |
+                       EOptionOutputHexadecimal))
+            Error("-E, -q, -i, -m, and -x cannot be used with --worker");
+        if (reflectBinaryName)
+            Error("--reflect-binary cannot be used with --worker");
+        if (PrintFingerprint)
+            Error("--fingerprint cannot be used with --worker");
+        if (PrintCounters)
+            Error("--counters cannot be used with --worker");
+    }
+
+    // Dumping a reflection binary reads just that file
+    if (dumpReflectBinaryName && (! workItems.empty() || (Options & EOptionStdin) || batchManifestName))
+        Error("input files cannot be given with --dump-reflect-binary");
+
     // Make sure that -S is always specified if --stdin is specified
     if ((Options & EOptionStdin) && shaderStageName == nullptr)
         Error("must provide -S when --stdin is given");
@@ -1074,12 +1181,28 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
     if (Options & EOptionOutputPreprocessed) {
         if (Options & EOptionLinkProgram)
             Error("can't use -E when linking is selected");
-        if (Options & EOptionDumpReflection)
+        if ((Options & EOptionDumpReflection) || reflectBinaryName)
             Error("reflection requires linking, which can't be used when -E when is selected");
     }
 
+    // --counters reports on TShader and TProgram, which only the linking modes use
+    if (PrintCounters) {
+        if (! glslang::CountersEnabled())
+            Error("--counters requires glslang to be built with ENABLE_COUNTERS");
+        if (! (Options & (EOptionLinkProgram | EOptionOutputPreprocessed)) && ! PrintFingerprint)
+            Error("--counters requires -l, -V, -G, -E, or --fingerprint");
+    }
+
+    // --fingerprint stops after preprocessing, so nothing downstream of it applies
+    if (PrintFingerprint) {
+        if (Options & (EOptionOutputPreprocessed | EOptionDumpReflection | EOptionIntermediate))
+            Error("--fingerprint cannot be used with -E, -q, or -i");
+        if (binaryFileName || reflectBinaryName)
+            Error("--fingerprint cannot be used with -o or --reflect-binary");
+    }
+
     // reflection requires linking
-    if ((Options & EOptionDumpReflection) && !(Options & EOptionLinkProgram))
+    if (((Options & EOptionDumpReflection) || reflectBinaryName) && !(Options & EOptionLinkProgram))
         Error("reflection requires -l for linking");
 
     // -o or -x makes no sense if there is no target binary
@@ -1166,6 +1289,30 @@ void SetMessageOptions(EShMessages& messages)
         messages = (EShMessages)(messages | EShMsgAbsolutePath);
 }
 
+//
+// Translate the command-line options to SPIR-V generation options.
+//
+void SetSpvOptions(glslang::SpvOptions& spvOptions)
+{
+    if (Options & EOptionDebug) {
+        spvOptions.generateDebugInfo = true;
+        if (emitNonSemanticShaderDebugInfo) {
+            spvOptions.emitNonSemanticShaderDebugInfo = true;
+            if (emitNonSemanticShaderDebugSource) {
+                spvOptions.emitNonSemanticShaderDebugSource = true;
+            }
+        }
+    } else if (stripDebugInfo)
+        spvOptions.stripDebugInfo = true;
+    spvOptions.disableOptimizer = (Options & EOptionOptimizeDisable) != 0;
+    spvOptions.optimizeSize = (Options & EOptionOptimizeSize) != 0;
+    spvOptions.disassemble = SpvToolsDisassembler;
+    spvOptions.validate = SpvToolsValidate || SpvToolsValidateConcurrent;
+    spvOptions.validateConcurrently = SpvToolsValidateConcurrent;
+    spvOptions.validateOptimized = SpvToolsValidate;
+    spvOptions.compileOnly = (Options & EOptionCompileOnly) != 0;
+}
+
 //
 // Thread entry point, for non-linking asynchronous mode.
 //
@@ -1223,6 +1370,16 @@ void StderrIfNonEmpty(const char* str)
         fprintf(stderr, "%s\n", str);
 }
 
+// Print the counters of --counters for one shader or linked stage.
+void PrintCompileCounters(const char* name, const glslang::TCompileCounters& counters)
+{
+    fprintf(stderr, "Counters of %s:\n", name);
+    for (int c = 0; c < glslang::ECounterCount; ++c) {
+        fprintf(stderr, "    %s: %llu\n", glslang::TCompileCounters::getName((glslang::TCounter)c),
+                counters[(glslang::TCounter)c]);
+    }
+}
+
 // Simple bundling of what makes a compilation unit for ease in passing around,
 // and separation of handling file IO versus API (programmatic) compilation.
 struct ShaderCompUnit {
@@ -1296,6 +1453,145 @@ bool writeDepFile(std::string depfile, std::vector<std::string>& binaryFiles, co
     return true;
 }
 
+//
+// Where a compile's output is headed.  The command line decides this for all
+// shaders, except that batch jobs can name their own --target-env.
+//
+struct TTargetEnv {
+    bool spv;
+    bool readHlsl;
+    glslang::EShClient client;
+    glslang::EShTargetClientVersion clientVersion;
+    glslang::EShTargetLanguage targetLanguage;
+    glslang::EShTargetLanguageVersion targetVersion;
+};
+
+TTargetEnv GetCommandLineTargetEnv()
+{
+    TTargetEnv env;
+    env.spv = (Options & EOptionSpv) != 0;
+    env.readHlsl = (Options & EOptionReadHlsl) != 0;
+    env.client = Client;
+    env.clientVersion = ClientVersion;
+    env.targetLanguage = TargetLanguage;
+    env.targetVersion = TargetVersion;
+
+    return env;
+}
+
+//
+// Apply the command-line settings that are common to every compilation unit.
+// Warnings go to 'log' if given, as batch jobs running on worker threads do,
+// and otherwise to stdout.
+//
+void SetShaderOptions(glslang::TShader& shader, EShLanguage stage, const TTargetEnv& env, const char* entryPoint,
+                      std::string* log = nullptr)
+{
+    if (entryPoint)
+        shader.setEntryPoint(entryPoint);
+    if (sourceEntryPointName) {
+        if (entryPoint == nullptr) {
+            const char* warning = "Warning: Changing source entry point name without setting an entry-point name.\n"
+                                  "Use '-e <name>'.\n";
+            if (log != nullptr)
+                log->append(warning);
+            else
+                printf("%s", warning);
+        }
+        shader.setSourceEntryPoint(sourceEntryPointName);
+    }
+
+    if (Options & EOptionCompileOnly)
+        shader.setCompileOnly();
+
+    shader.setOverrideVersion(GlslVersion);
+
+    // Set IO mapper binding shift values
+    for (int r = 0; r < glslang::EResCount; ++r) {
+        const glslang::TResourceType res = glslang::TResourceType(r);
+
+        // Set base bindings
+        shader.setShiftBinding(res, baseBinding[res][stage]);
+
+        // Set bindings for particular resource sets
+        // TODO: use a range based for loop here, when available in all environments.
+        for (auto i = baseBindingForSet[res][stage].begin();
+             i != baseBindingForSet[res][stage].end(); ++i)
+            shader.setShiftBindingForSet(res, i->second, i->first);
+    }
+    shader.setNoStorageFormat((Options & EOptionNoStorageFormat) != 0);
+    shader.setResourceSetBinding(baseResourceSetBinding[stage]);
+
+    if (autoSampledTextures)
+        shader.setTextureSamplerTransformMode(EShTexSampTransUpgradeTextureRemoveSampler);
+
+    if (Options & EOptionAutoMapBindings)
+        shader.setAutoMapBindings(true);
+
+    if (Options & EOptionAutoMapLocations)
+        shader.setAutoMapLocations(true);
+
+    for (auto& uniOverride : uniformLocationOverrides) {
+        shader.addUniformLocationOverride(uniOverride.first.c_str(),
+                                          uniOverride.second);
+    }
+
+    shader.setUniformLocationBase(uniformBase);
+
+    if (VulkanRulesRelaxed) {
+        for (auto& storageOverride : blockStorageOverrides) {
+            shader.addBlockStorageOverride(storageOverride.first.c_str(),
+                storageOverride.second);
+        }
+
+        if (setGlobalBufferBlock) {
+            shader.setAtomicCounterBlockName(atomicCounterBlockName.c_str());
+            shader.setAtomicCounterBlockSet(atomicCounterBlockSet);
+        }
+
+        if (setGlobalUniformBlock) {
+            shader.setGlobalUniformBlockName(globalUniformName.c_str());
+            shader.setGlobalUniformSet(globalUniformSet);
+            shader.setGlobalUniformBinding(globalUniformBinding);
+        }
+    }
+
+    shader.setNanMinMaxClamp(NaNClamp);
+
+#ifdef ENABLE_HLSL
+    shader.setFlattenUniformArrays((Options & EOptionFlattenUniformArrays) != 0);
+    if (Options & EOptionHlslIoMapping)
+        shader.setHlslIoMapping(true);
+#endif
+
+    if (Options & EOptionInvertY)
+        shader.setInvertY(true);
+
+    if (HlslDxPositionW)
+        shader.setDxPositionW(true);
+
+    if (EnhancedMsgs)
+        shader.setEnhancedMsgs();
+
+    if (emitNonSemanticShaderDebugInfo)
+        shader.setDebugInfo(true);
+
+    // Set up the environment, some subsettings take precedence over earlier
+    // ways of setting things.
+    if (env.spv) {
+        shader.setEnvInput(env.readHlsl ? glslang::EShSourceHlsl : glslang::EShSourceGlsl,
+                           stage, env.client, ClientInputSemanticsVersion);
+        shader.setEnvClient(env.client, env.clientVersion);
+        shader.setEnvTarget(env.targetLanguage, env.targetVersion);
+#ifdef ENABLE_HLSL
+        if (targetHlslFunctionality1)
+            shader.setEnvTargetHlslFunctionality1();
+#endif
+        if (VulkanRulesRelaxed)
+            shader.setEnvInputVulkanRulesRelaxed();
+    }
+}
+
 //
 // For linking mode: Will independently parse each compilation unit, but then put them
 // in the same program and link them together, making at most one linked module per
@@ -1331,19 +1627,8 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
         }
         glslang::TShader* shader = new glslang::TShader(compUnit.stage);
         shader->setStringsWithLengthsAndNames(compUnit.text, nullptr, compUnit.fileNameList, compUnit.count);
-        if (entryPointName)
-            shader->setEntryPoint(entryPointName);
-        if (sourceEntryPointName) {
-            if (entryPointName == nullptr)
-                printf("Warning: Changing source entry point name without setting an entry-point name.\n"
-                       "Use '-e <name>'.\n");
-            shader->setSourceEntryPoint(sourceEntryPointName);
-        }
-
-        if (compileOnly)
-            shader->setCompileOnly();
-
-        shader->setOverrideVersion(GlslVersion);
+        shader->setStringsRetained(true);  // the file data is freed after the shaders
+        SetShaderOptions(*shader, compUnit.stage, GetCommandLineTargetEnv(), entryPointName);
 
         std::string intrinsicString = getIntrinsic(compUnit.text, compUnit.count);
 
@@ -1357,96 +1642,25 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
         shader->setPreamble(PreambleString.c_str());
         shader->addProcesses(Processes);
 
-        // Set IO mapper binding shift values
-        for (int r = 0; r < glslang::EResCount; ++r) {
-            const glslang::TResourceType res = glslang::TResourceType(r);
-
-            // Set base bindings
-            shader->setShiftBinding(res, baseBinding[res][compUnit.stage]);
-
-            // Set bindings for particular resource sets
-            // TODO: use a range based for loop here, when available in all environments.
-            for (auto i = baseBindingForSet[res][compUnit.stage].begin();
-                 i != baseBindingForSet[res][compUnit.stage].end(); ++i)
-                shader->setShiftBindingForSet(res, i->second, i->first);
-        }
-        shader->setNoStorageFormat((Options & EOptionNoStorageFormat) != 0);
-        shader->setResourceSetBinding(baseResourceSetBinding[compUnit.stage]);
-
-        if (autoSampledTextures)
-            shader->setTextureSamplerTransformMode(EShTexSampTransUpgradeTextureRemoveSampler);
-
-        if (Options & EOptionAutoMapBindings)
-            shader->setAutoMapBindings(true);
-
-        if (Options & EOptionAutoMapLocations)
-            shader->setAutoMapLocations(true);
-
-        for (auto& uniOverride : uniformLocationOverrides) {
-            shader->addUniformLocationOverride(uniOverride.first.c_str(),
-                                               uniOverride.second);
-        }
-
-        shader->setUniformLocationBase(uniformBase);
-
-        if (VulkanRulesRelaxed) {
-            for (auto& storageOverride : blockStorageOverrides) {
-                shader->addBlockStorageOverride(storageOverride.first.c_str(),
-                    storageOverride.second);
-            }
+        shaders.push_back(shader);
 
-            if (setGlobalBufferBlock) {
-                shader->setAtomicCounterBlockName(atomicCounterBlockName.c_str());
-                shader->setAtomicCounterBlockSet(atomicCounterBlockSet);
-            }
+        const int defaultVersion = Options & EOptionDefaultDesktop ? 110 : 100;
 
-            if (setGlobalUniformBlock) {
-                shader->setGlobalUniformBlockName(globalUniformName.c_str());
-                shader->setGlobalUniformSet(globalUniformSet);
-                shader->setGlobalUniformBinding(globalUniformBinding);
+        if (PrintFingerprint) {
+            unsigned long long fingerprint = 0;
+            if (shader->fingerprint(GetResources(), defaultVersion, ENoProfile, false, false, messages, &fingerprint,
+                                    includer)) {
+                printf("%016llx %s\n", fingerprint, compUnit.fileName[0].c_str());
+            } else {
+                CompileFailed = 1;
             }
+            StderrIfNonEmpty(shader->getInfoLog());
+            StderrIfNonEmpty(shader->getInfoDebugLog());
+            if (PrintCounters)
+                PrintCompileCounters(compUnit.fileName[0].c_str(), shader->getCounters());
+            continue;
         }
 
-        shader->setNanMinMaxClamp(NaNClamp);
-
-#ifdef ENABLE_HLSL
-        shader->setFlattenUniformArrays((Options & EOptionFlattenUniformArrays) != 0);
-        if (Options & EOptionHlslIoMapping)
-            shader->setHlslIoMapping(true);
-#endif
-
-        if (Options & EOptionInvertY)
-            shader->setInvertY(true);
-
-        if (HlslDxPositionW)
-            shader->setDxPositionW(true);
-
-        if (EnhancedMsgs)
-            shader->setEnhancedMsgs();
-
-        if (emitNonSemanticShaderDebugInfo)
-            shader->setDebugInfo(true);
-
-        // Set up the environment, some subsettings take precedence over earlier
-        // ways of setting things.
-        if (Options & EOptionSpv) {
-            shader->setEnvInput((Options & EOptionReadHlsl) ? glslang::EShSourceHlsl
-                                                            : glslang::EShSourceGlsl,
-                                compUnit.stage, Client, ClientInputSemanticsVersion);
-            shader->setEnvClient(Client, ClientVersion);
-            shader->setEnvTarget(TargetLanguage, TargetVersion);
-#ifdef ENABLE_HLSL
-            if (targetHlslFunctionality1)
-                shader->setEnvTargetHlslFunctionality1();
-#endif
-            if (VulkanRulesRelaxed)
-                shader->setEnvInputVulkanRulesRelaxed();
-        }
-
-        shaders.push_back(shader);
-
-        const int defaultVersion = Options & EOptionDefaultDesktop ? 110 : 100;
-
         if (Options & EOptionOutputPreprocessed) {
             std::string str;
             if (shader->preprocess(GetResources(), defaultVersion, ENoProfile, false, false, messages, &str, includer)) {
@@ -1456,6 +1670,8 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
             }
             StderrIfNonEmpty(shader->getInfoLog());
             StderrIfNonEmpty(shader->getInfoDebugLog());
+            if (PrintCounters)
+                PrintCompileCounters(compUnit.fileName[0].c_str(), shader->getCounters());
             continue;
         }
 
@@ -1472,6 +1688,18 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
             PutsIfNonEmpty(shader->getInfoLog());
             PutsIfNonEmpty(shader->getInfoDebugLog());
         }
+        if (PrintCounters)
+            PrintCompileCounters(compUnit.fileName[0].c_str(), shader->getCounters());
+    }
+
+    // Fingerprints are all there is to report
+    if (PrintFingerprint) {
+        delete &program;
+        while (shaders.size() > 0) {
+            delete shaders.back();
+            shaders.pop_back();
+        }
+        return;
     }
 
     //
@@ -1496,9 +1724,16 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
         }
 
         // Reflect
-        if (Options & EOptionDumpReflection) {
+        if ((Options & EOptionDumpReflection) || reflectBinaryName) {
             program.buildReflection(ReflectOptions);
-            program.dumpReflection();
+            if (Options & EOptionDumpReflection)
+                program.dumpReflection();
+            if (reflectBinaryName) {
+                std::vector<unsigned int> reflectionBinary;
+                if (! program.getReflectionBinary(reflectionBinary) ||
+                    ! glslang::OutputSpvBin(reflectionBinary, reflectBinaryName))
+                    LinkFailed = true;
+            }
         }
     }
 
@@ -1525,26 +1760,43 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
                     }
                 }
             }
-            for (auto* intermediate : intermediates) {
-                std::vector<unsigned int> spirv;
-                spv::SpvBuildLogger logger;
+            std::vector<std::vector<unsigned int>> spirvs(intermediates.size());
+            std::vector<spv::SpvBuildLogger> loggers(intermediates.size());
+            const bool parallel = SpvParallelStages && intermediates.size() > 1;
+            const auto generate = [&](size_t i) {
                 glslang::SpvOptions spvOptions;
-                if (Options & EOptionDebug) {
-                    spvOptions.generateDebugInfo = true;
-                    if (emitNonSemanticShaderDebugInfo) {
-                        spvOptions.emitNonSemanticShaderDebugInfo = true;
-                        if (emitNonSemanticShaderDebugSource) {
-                            spvOptions.emitNonSemanticShaderDebugSource = true;
-                        }
+                SetSpvOptions(spvOptions);
+                if (parallel)
+                    spvOptions.disassemble = false;  // done below, in order
+                glslang::GlslangToSpv(*intermediates[i], spirvs[i], &loggers[i], &spvOptions);
+            };
+
+            // The frozen program's stages are translated concurrently, each thread
+            // allocating from its own default pool
+            if (parallel) {
+                if (!compileOnly)
+                    program.freeze();
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < intermediates.size(); ++i) {
+                    threads.emplace_back(generate, i);
+                    if (threads.back().get_id() == std::thread::id()) {
+                        fprintf(stderr, "Failed to create thread\n");
+                        exit(EFailThreadCreate);
                     }
-                } else if (stripDebugInfo)
-                    spvOptions.stripDebugInfo = true;
-                spvOptions.disableOptimizer = (Options & EOptionOptimizeDisable) != 0;
-                spvOptions.optimizeSize = (Options & EOptionOptimizeSize) != 0;
-                spvOptions.disassemble = SpvToolsDisassembler;
-                spvOptions.validate = SpvToolsValidate;
-                spvOptions.compileOnly = compileOnly;
-                glslang::GlslangToSpv(*intermediate, spirv, &logger, &spvOptions);
+                }
+                std::for_each(threads.begin(), threads.end(), [](std::thread& t) { t.join(); });
+            }
+
+            for (size_t i = 0; i < intermediates.size(); ++i) {
+                glslang::TIntermediate* intermediate = intermediates[i];
+                std::vector<unsigned int>& spirv = spirvs[i];
+                const spv::SpvBuildLogger& logger = loggers[i];
+                if (!parallel)
+                    generate(i);
+#if ENABLE_OPT
+                else if (SpvToolsDisassembler)
+                    glslang::SpirvToolsDisassemble(std::cout, spirv);
+#endif
 
                 // Dump the spv to a file or stdout, etc., but only if not doing
                 // memory/perf testing, as it's not internal to programmatic use.
@@ -1563,6 +1815,11 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
                     if (!SpvToolsDisassembler && (Options & EOptionHumanReadableSpv))
                         spv::Disassemble(std::cout, spirv);
                 }
+                if (PrintCounters) {
+                    std::string name = std::string("SPIR-V generation of ") +
+                                       glslang::StageName(intermediate->getStage()) + " stage";
+                    PrintCompileCounters(name.c_str(), logger.getCounters());
+                }
             }
         }
     }
@@ -1576,6 +1833,15 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
         writeDepFile(depencyFileName, outputFiles, sources);
     }
 
+    if (PrintCounters && !compileOnly) {
+        for (int stage = 0; stage < EShLangCount; ++stage) {
+            if (program.getIntermediate((EShLanguage)stage) != nullptr) {
+                std::string name = std::string("linked ") + glslang::StageName((EShLanguage)stage) + " stage";
+                PrintCompileCounters(name.c_str(), program.getCounters((EShLanguage)stage));
+            }
+        }
+    }
+
     // Free everything up, program has to go before the shaders
     // because it might have merged stuff from the shaders, and
     // the stuff from the shaders has to have its destructors called
@@ -1649,6 +1915,575 @@ void CompileAndLinkShaderFiles(glslang::TWorklist& Worklist)
         FreeFileData(const_cast<char*>(it->text[0]));
 }
 
+//
+// Batch mode: compile every job of a manifest in this one process, on a pool
+// of worker threads.  Built-in symbol tables are built once and shared by all
+// jobs, as are resource limits and the contents of source and include files.
+// The command line's options apply to every job; the manifest adds each job's
+// inputs, stage, macros, target environment, entry point, and output file.
+//
+
+//
+// Apply a batch job's "target-env" on top of the command line's environment.
+//
+bool SetBatchTargetEnv(const std::string& name, TTargetEnv& env)
+{
+    static const struct {
+        const char* name;
+        glslang::EShClient client;  // EShClientNone: keep the command line's client
+        glslang::EShTargetClientVersion clientVersion;
+        glslang::EShTargetLanguageVersion targetVersion;
+    } targetEnvs[] = {
+        { "vulkan1.0", glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0, glslang::EShTargetSpv_1_0 },
+        { "vulkan1.1", glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1, glslang::EShTargetSpv_1_3 },
+        { "vulkan1.2", glslang::EShClientVulkan, glslang::EShTargetVulkan_1_2, glslang::EShTargetSpv_1_5 },
+        { "vulkan1.3", glslang::EShClientVulkan, glslang::EShTargetVulkan_1_3, glslang::EShTargetSpv_1_6 },
+        { "opengl",    glslang::EShClientOpenGL, glslang::EShTargetOpenGL_450, glslang::EShTargetSpv_1_0 },
+        { "spirv1.0",  glslang::EShClientNone,   glslang::EShTargetClientVersionCount, glslang::EShTargetSpv_1_0 },
+        { "spirv1.1",  glslang::EShClientNone,   glslang::EShTargetClientVersionCount, glslang::EShTargetSpv_1_1 },
+        { "spirv1.2",  glslang::EShClientNone,   glslang::EShTargetClientVersionCount, glslang::EShTargetSpv_1_2 },
+        { "spirv1.3",  glslang::EShClientNone,   glslang::EShTargetClientVersionCount, glslang::EShTargetSpv_1_3 },
+        { "spirv1.4",  glslang::EShClientNone,   glslang::EShTargetClientVersionCount, glslang::EShTargetSpv_1_4 },
+        { "spirv1.5",  glslang::EShClientNone,   glslang::EShTargetClientVersionCount, glslang::EShTargetSpv_1_5 },
+        { "spirv1.6",  glslang::EShClientNone,   glslang::EShTargetClientVersionCount, glslang::EShTargetSpv_1_6 },
+    };
+
+    for (const auto& targetEnv : targetEnvs) {
+        if (name != targetEnv.name)
+            continue;
+        if (targetEnv.client != glslang::EShClientNone) {
+            env.client = targetEnv.client;
+            env.clientVersion = targetEnv.clientVersion;
+        }
+        env.targetLanguage = glslang::EShTargetSpv;
+        env.targetVersion = targetEnv.targetVersion;
+        env.spv = true;
+        return true;
+    }
+
+    return false;
+}
+
+//
+// Where a batch job's module for 'stage' is written.  Jobs producing a single
+// module write it to "output", or to <first input>.spv; jobs producing several
+// add the stage, as in <output>.vert.spv.
+//
+std::string GetBatchBinaryName(const glslang::TBatchJob& job, EShLanguage stage, bool multipleModules)
+{
+    if (! multipleModules)
+        return job.output.empty() ? job.inputs.front() + ".spv" : job.output;
+
+    return (job.output.empty() ? job.inputs.front() : job.output) + "." + GetBinaryName(stage);
+}
+
+// The SPIR-V of each stage of a job, for jobs whose modules are not written to files
+typedef std::vector<std::pair<EShLanguage, std::vector<unsigned int>>> TBatchModules;
+
+//
+// Compile, link, and generate SPIR-V for one batch job.  Runs on a worker thread,
+// so it only reads the command-line globals, and everything it has to say goes
+// into the job's log rather than to stdout.  If 'modules' is given, the SPIR-V
+// goes there instead of to the job's output files.
+//
+void CompileBatchJob(glslang::TBatchJob& job, glslang::TIncludeCache& includeCache, TBatchModules* modules = nullptr)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::string& log = job.log;
+    const bool compileOnly = (Options & EOptionCompileOnly) != 0;
+
+    TTargetEnv env = GetCommandLineTargetEnv();
+    if (! job.targetEnv.empty()) {
+        if (! SetBatchTargetEnv(job.targetEnv, env)) {
+            log.append("unknown target-env: ").append(job.targetEnv).append("\n");
+            job.compileFailed = true;
+        } else if (env.client == glslang::EShClientNone) {
+            log.append("target-env ").append(job.targetEnv).append(" needs client semantics (see -G and -V)\n");
+            job.compileFailed = true;
+        }
+    }
+
+    const size_t count = job.inputs.size();
+    std::vector<EShLanguage> stages(count);
+    for (size_t i = 0; i < count; ++i) {
+        bool isHlsl = false;
+        const char* stageOverride = job.stage.empty() ? shaderStageName : job.stage.c_str();
+        if (! DeduceLanguage(job.inputs[i], stageOverride, true, stages[i], isHlsl)) {
+            log.append(job.inputs[i]).append(": cannot deduce the shader stage\n");
+            job.compileFailed = true;
+        }
+        env.readHlsl = env.readHlsl || isHlsl;
+    }
+    if (env.readHlsl && ! env.spv) {
+        log.append("HLSL requires SPIR-V code generation\n");
+        job.compileFailed = true;
+    }
+
+    if (job.compileFailed) {
+        job.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return;
+    }
+
+    EShMessages messages = EShMsgDefault;
+    SetMessageOptions(messages);
+    if (env.spv)
+        messages = (EShMessages)(messages | EShMsgSpvRules);
+    if (env.client == glslang::EShClientVulkan)
+        messages = (EShMessages)(messages | EShMsgVulkanRules);
+    else if (env.client == glslang::EShClientOpenGL)
+        messages = (EShMessages)(messages & ~EShMsgVulkanRules);
+    if (env.readHlsl)
+        messages = (EShMessages)(messages | EShMsgReadHlsl);
+
+    // The job's macros follow the command line's, and are recorded with them.
+    std::vector<std::string> processes(Processes);
+    TPreamble jobPreamble(processes);
+    for (const auto& define : job.defines)
+        jobPreamble.addDef(define);
+
+    glslang::TCachedFileIncluder includer(includeCache);
+    std::for_each(IncludeDirectoryList.rbegin(), IncludeDirectoryList.rend(), [&includer](const std::string& dir) {
+        includer.pushExternalLocalDirectory(dir); });
+
+    // These all must outlive the shaders, and the program must go before the shaders.
+    std::vector<const char*> texts(count);
+    std::vector<const char*> names(count);
+    std::vector<std::string> preambles(count);
+    std::vector<std::unique_ptr<glslang::TShader>> shaders;
+    glslang::TProgram program;
+
+    const int defaultVersion = Options & EOptionDefaultDesktop ? 110 : 100;
+    const char* entryPoint = job.entryPoint.empty() ? entryPointName : job.entryPoint.c_str();
+    for (size_t i = 0; i < count; ++i) {
+        const std::string* source = includeCache.read(job.inputs[i]);
+        if (source == nullptr) {
+            log.append(job.inputs[i]).append(": unable to open input file\n");
+            job.compileFailed = true;
+            continue;
+        }
+        texts[i] = source->c_str();
+        if (source->compare(0, 3, "\xef\xbb\xbf") == 0)
+            texts[i] += 3;  // skip BOM
+        names[i] = job.inputs[i].c_str();
+
+        shaders.emplace_back(new glslang::TShader(stages[i]));
+        glslang::TShader& shader = *shaders.back();
+        shader.setStringsWithLengthsAndNames(&texts[i], nullptr, &names[i], 1);
+        shader.setStringsRetained(true);  // the include cache outlives the batch
+        SetShaderOptions(shader, stages[i], env, entryPoint, &log);
+
+        if (UserPreamble.isSet())
+            preambles[i].append(UserPreamble.get());
+        if (jobPreamble.isSet())
+            preambles[i].append(jobPreamble.get());
+        preambles[i].append(getIntrinsic(&texts[i], 1));
+        shader.setPreamble(preambles[i].c_str());
+        shader.addProcesses(processes);
+
+        if (! shader.parse(GetResources(), defaultVersion, false, messages, includer))
+            job.compileFailed = true;
+
+        if (! compileOnly)
+            program.addShader(&shader);
+
+        if (! (Options & EOptionSuppressInfolog)) {
+            log.append(job.inputs[i]).append("\n");
+            log.append(shader.getInfoLog());
+            log.append(shader.getInfoDebugLog());
+        }
+    }
+
+    if (! job.compileFailed && ! compileOnly) {
+        if (! program.link(messages))
+            job.linkFailed = true;
+        if (env.spv && ! job.linkFailed && ! program.mapIO())
+            job.linkFailed = true;
+
+        if (! (Options & EOptionSuppressInfolog)) {
+            log.append(program.getInfoLog());
+            log.append(program.getInfoDebugLog());
+        }
+    }
+
+    if (env.spv && job.succeeded()) {
+        std::vector<glslang::TIntermediate*> intermediates;
+        if (! compileOnly) {
+            for (int stage = 0; stage < EShLangCount; ++stage) {
+                if (auto* i = program.getIntermediate((EShLanguage)stage))
+                    intermediates.emplace_back(i);
+            }
+        } else {
+            for (const auto& shader : shaders) {
+                if (auto* i = shader->getIntermediate())
+                    intermediates.emplace_back(i);
+            }
+        }
+
+        for (auto* intermediate : intermediates) {
+            std::vector<unsigned int> spirv;
+            spv::SpvBuildLogger logger;
+            glslang::SpvOptions spvOptions;
+            SetSpvOptions(spvOptions);
+            spvOptions.disassemble = false;  // would go to stdout
+            glslang::GlslangToSpv(*intermediate, spirv, &logger, &spvOptions);
+            log.append(logger.getAllMessages());
+
+            if (modules == nullptr) {
+                const std::string fileName = GetBatchBinaryName(job, intermediate->getStage(), intermediates.size() > 1);
+                const bool written = (Options & EOptionOutputHexadecimal) ?
+                                         glslang::OutputSpvHex(spirv, fileName.c_str(), variableName) :
+                                         glslang::OutputSpvBin(spirv, fileName.c_str());
+                if (! written) {
+                    log.append("unable to write ").append(fileName).append("\n");
+                    job.outputFailed = true;
+                    continue;
+                }
+                job.outputs.push_back(fileName);
+            }
+
+            if (Options & EOptionHumanReadableSpv) {
+                std::ostringstream disassembly;
+                spv::Disassemble(disassembly, spirv);
+                log.append(disassembly.str());
+            }
+
+            if (modules != nullptr)
+                modules->emplace_back(intermediate->getStage(), std::move(spirv));
+        }
+    }
+
+    job.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// Write the batch summary: per job its inputs, outputs, status, time, and log,
+// in manifest order.
+//
+void WriteBatchSummary(std::ostream& out, const std::vector<glslang::TBatchJob>& jobs, unsigned int threads,
+                       double milliseconds)
+{
+    const auto writeList = [&out](const std::vector<std::string>& list) {
+        out << "[";
+        for (size_t i = 0; i < list.size(); ++i)
+            out << (i > 0 ? ", " : "") << glslang::JsonQuote(list[i]);
+        out << "]";
+    };
+
+    out << "{\n";
+    out << "  \"threads\": " << threads << ",\n";
+    out << "  \"milliseconds\": " << milliseconds << ",\n";
+    out << "  \"jobs\": [";
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const glslang::TBatchJob& job = jobs[j];
+        const char* status = job.compileFailed ? "compile-failed" :
+                             job.linkFailed    ? "link-failed" :
+                             job.outputFailed  ? "output-failed" : "success";
+        out << (j > 0 ? ",\n" : "\n");
+        out << "    {\n";
+        out << "      \"inputs\": ";
+        writeList(job.inputs);
+        out << ",\n";
+        out << "      \"outputs\": ";
+        writeList(job.outputs);
+        out << ",\n";
+        out << "      \"status\": \"" << status << "\",\n";
+        out << "      \"milliseconds\": " << job.milliseconds << ",\n";
+        out << "      \"log\": " << glslang::JsonQuote(job.log) << "\n";
+        out << "    }";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+}
+
+int BatchMain()
+{
+    std::vector<glslang::TBatchJob> jobs;
+    {
+        char* manifestText = ReadFileData(batchManifestName);
+        const std::string manifest(manifestText);
+        FreeFileData(manifestText);
+
+        std::string error;
+        glslang::TBatchManifestReader reader(manifest);
+        if (! reader.read(jobs, error))
+            Error(error.c_str(), batchManifestName);
+    }
+
+    ProcessConfigFile();
+
+    unsigned int threadCount = batchThreads;
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max(1u, (unsigned int)jobs.size()));
+
+    const auto start = std::chrono::steady_clock::now();
+
+    glslang::InitializeProcess();
+
+    glslang::TIncludeCache includeCache;
+    std::atomic<size_t> nextJob{0};
+    const auto worker = [&jobs, &includeCache, &nextJob]() {
+        for (size_t j = nextJob++; j < jobs.size(); j = nextJob++)
+            CompileBatchJob(jobs[j], includeCache);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+        if (threads.back().get_id() == std::thread::id()) {
+            fprintf(stderr, "Failed to create thread\n");
+            return EFailThreadCreate;
+        }
+    }
+    worker();
+    std::for_each(threads.begin(), threads.end(), [](std::thread& t) { t.join(); });
+
+    glslang::FinalizeProcess();
+
+    const double milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (batchSummaryName != nullptr) {
+        std::ofstream summary(batchSummaryName);
+        if (summary.fail())
+            Error("unable to open summary file", batchSummaryName);
+        WriteBatchSummary(summary, jobs, threadCount, milliseconds);
+    } else if (! beQuiet)
+        WriteBatchSummary(std::cout, jobs, threadCount, milliseconds);
+
+    for (const auto& job : jobs) {
+        if (job.compileFailed)
+            return EFailCompile;
+    }
+    for (const auto& job : jobs) {
+        if (! job.succeeded())
+            return EFailLink;
+    }
+
+    return ESuccess;
+}
+
+#ifndef _WIN32
+
+//
+// Worker mode: serve compile jobs from clients of glslang/Public/CompileWorker.h over
+// a local socket.  Each connection is served by a process forked from the listener,
+// so a compile that crashes ends only its own connection.  The listener makes the
+// built-in symbol tables of the command line's target before forking, and those made
+// by one job of a connection are there for the next.  As in batch mode, the command
+// line's options apply to every job.
+//
+
+//
+// Compile one job from a client.  Its sources are seen through the include cache
+// under their names, so "" includes are searched for next to them.
+//
+glslang::TCompileWorkerStatus CompileWorkerJob(const glslang::TCompileWorkerJob& workerJob, std::string& log,
+                                               TBatchModules& modules)
+{
+    glslang::TBatchJob job;
+    glslang::TIncludeCache includeCache;
+    for (const auto& source : workerJob.sources) {
+        job.inputs.push_back(source.name);
+        includeCache.add(source.name, source.text);
+    }
+    job.stage = workerJob.stage;
+    job.defines = workerJob.defines;
+    job.targetEnv = workerJob.targetEnv;
+    job.entryPoint = workerJob.entryPoint;
+
+    if (job.inputs.empty()) {
+        log = "job has no sources\n";
+        return glslang::ECompileWorkerBadJob;
+    }
+
+    CompileBatchJob(job, includeCache, &modules);
+    log.swap(job.log);
+
+    return job.compileFailed ? glslang::ECompileWorkerCompileFailed :
+           job.linkFailed    ? glslang::ECompileWorkerLinkFailed : glslang::ECompileWorkerSuccess;
+}
+
+//
+// Send a job's result: through the ring if it fits in the space the client has
+// released, and over the socket if not.  Results are contiguous in the ring,
+// skipping its end if need be, and start on 8 bytes.
+//
+bool SendWorkerResult(glslang::TCompileWorkerConnection& connection, glslang::TCompileWorkerRing& ring,
+                      uint64_t capacity, glslang::TCompileWorkerStatus status, const std::string& log,
+                      const TBatchModules& modules)
+{
+    glslang::TCompileWorkerResultHeader header = {};
+    header.status = status;
+    header.moduleCount = static_cast<uint32_t>(modules.size());
+    header.logSize = log.size();
+    header.size = glslang::CompileWorkerPad(log.size(), 4);
+    std::vector<glslang::TCompileWorkerModule> moduleHeaders;
+    for (const auto& module : modules) {
+        moduleHeaders.push_back({ static_cast<uint32_t>(module.first), static_cast<uint32_t>(module.second.size()) });
+        header.size += module.second.size() * sizeof(unsigned int);
+    }
+
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    const uint64_t used = head - ring.tail.load(std::memory_order_acquire);
+    const uint64_t available = used > capacity ? 0 : capacity - used;
+    const uint64_t start = head % capacity;
+    const uint64_t reserved = glslang::CompileWorkerPad(header.size, 8);
+    const uint64_t skip = start + reserved > capacity ? capacity - start : 0;
+
+    std::string inlineData;
+    char* data;
+    if (skip + reserved <= available) {
+        header.offset = skip > 0 ? 0 : start;
+        header.ringEnd = head + skip + reserved;
+        data = ring.getData() + header.offset;
+    } else {
+        header.offset = glslang::CompileWorkerInline;
+        header.ringEnd = head;
+        inlineData.resize(static_cast<size_t>(header.size));
+        data = &inlineData[0];
+    }
+
+    memcpy(data, log.data(), log.size());
+    memset(data + log.size(), 0, static_cast<size_t>(glslang::CompileWorkerPad(log.size(), 4)) - log.size());
+    data += glslang::CompileWorkerPad(log.size(), 4);
+    for (const auto& module : modules) {
+        memcpy(data, module.second.data(), module.second.size() * sizeof(unsigned int));
+        data += module.second.size() * sizeof(unsigned int);
+    }
+    if (header.offset != glslang::CompileWorkerInline)
+        ring.head.store(header.ringEnd, std::memory_order_release);
+
+    const size_t modulesSize = moduleHeaders.size() * sizeof(glslang::TCompileWorkerModule);
+    return connection.writeHeader(glslang::ECompileWorkerResult, sizeof(header) + modulesSize + inlineData.size()) &&
+           connection.writeAll(&header, sizeof(header)) && connection.writeAll(moduleHeaders.data(), modulesSize) &&
+           connection.writeAll(inlineData.data(), inlineData.size());
+}
+
+//
+// Serve the jobs of one connection, until the client goes away.
+//
+void ServeWorkerConnection(int fd)
+{
+    glslang::TCompileWorkerConnection connection(fd);
+    const int ringFd = connection.receiveHello();
+    if (ringFd < 0)
+        return;
+
+    struct stat ringStat;
+    void* mapping = MAP_FAILED;
+    if (fstat(ringFd, &ringStat) == 0 && static_cast<size_t>(ringStat.st_size) > sizeof(glslang::TCompileWorkerRing))
+        mapping = mmap(nullptr, static_cast<size_t>(ringStat.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, ringFd, 0);
+    close(ringFd);
+    if (mapping == MAP_FAILED)
+        return;
+
+    // the capacity is read once, so the client cannot move the ring's bounds later
+    glslang::TCompileWorkerRing& ring = *static_cast<glslang::TCompileWorkerRing*>(mapping);
+    const uint64_t capacity = ring.capacity;
+    if (ring.magic != glslang::CompileWorkerMagic || ring.version != glslang::CompileWorkerVersion || capacity == 0 ||
+        capacity % 8 != 0 || capacity > static_cast<size_t>(ringStat.st_size) - sizeof(ring))
+        return;
+
+    std::vector<char> payload;
+    uint32_t type;
+    uint64_t size;
+    while (connection.readHeader(type, size) && type == glslang::ECompileWorkerJob) {
+        payload.resize(static_cast<size_t>(size));
+        if (! connection.readAll(payload.data(), payload.size()))
+            return;
+
+        glslang::TCompileWorkerJob job;
+        glslang::TCompileWorkerStatus status;
+        std::string log;
+        TBatchModules modules;
+        if (job.deserialize(payload.data(), payload.size()))
+            status = CompileWorkerJob(job, log, modules);
+        else {
+            status = glslang::ECompileWorkerBadJob;
+            log = "malformed job\n";
+        }
+
+        if (! SendWorkerResult(connection, ring, capacity, status, log, modules))
+            return;
+    }
+}
+
+//
+// Build the built-in symbol tables of the command line's target, shared and per stage,
+// before taking connections, so each forked process starts out with them instead of
+// parsing its own.  The tables are made before a shader is parsed, so it does not matter
+// whether these trivial ones compile.
+//
+void WarmWorkerBuiltIns()
+{
+    static const char* const stages[] = { "vert", "tesc", "tese", "geom", "frag", "comp" };
+    const char* source = (Options & EOptionReadHlsl) ? "void main() {}\n" : "#version 450\nvoid main() {}\n";
+    for (const char* stage : stages) {
+        glslang::TBatchJob job;
+        glslang::TIncludeCache includeCache;
+        job.inputs.push_back(std::string("warm.") + stage);
+        job.stage = stage;
+        includeCache.add(job.inputs.back(), source);
+
+        TBatchModules modules;
+        CompileBatchJob(job, includeCache, &modules);
+    }
+}
+
+int WorkerMain()
+{
+    ProcessConfigFile();
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (strlen(workerSocketName) >= sizeof(address.sun_path))
+        Error("socket path is too long", workerSocketName);
+    strcpy(address.sun_path, workerSocketName);
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(workerSocketName);  // left by an earlier worker
+    if (listener < 0 || bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, SOMAXCONN) != 0)
+        Error("unable to listen on socket", workerSocketName);
+
+    // Exited children are reaped by the system, and a client going away must not
+    // take a process down with SIGPIPE.
+    signal(SIGCHLD, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+
+    glslang::InitializeProcess();
+    WarmWorkerBuiltIns();
+
+    for (;;) {
+        const int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            Error("unable to accept a connection on socket", workerSocketName);
+        }
+
+        const pid_t child = fork();
+        if (child == 0) {
+            close(listener);
+            ServeWorkerConnection(connection);
+            _exit(ESuccess);
+        }
+        if (child < 0)
+            fprintf(stderr, "%s: unable to start a process for a connection\n", ExecutableName);
+        close(connection);
+    }
+}
+
+#else
+
+int WorkerMain()
+{
+    return EFailUsage;
+}
+
+#endif
+
 int singleMain()
 {
     glslang::TWorklist workList;
@@ -1704,7 +2539,7 @@ int singleMain()
     // 1) linking all arguments together, single-threaded, new C++ interface
     // 2) independent arguments, can be tackled by multiple asynchronous threads, for testing thread safety, using the old handle interface
     //
-    if (Options & (EOptionLinkProgram | EOptionOutputPreprocessed)) {
+    if ((Options & (EOptionLinkProgram | EOptionOutputPreprocessed)) || PrintFingerprint) {
         glslang::InitializeProcess();
         glslang::InitializeProcess();  // also test reference counting of users
         glslang::InitializeProcess();  // also test reference counting of users
@@ -1753,10 +2588,79 @@ int singleMain()
     return 0;
 }
 
+//
+// Print a reflection binary written by --reflect-binary, read back through
+// TReflectionBinary, in the same form as -q prints the reflection.
+//
+int DumpReflectionBinary()
+{
+    std::ifstream in(dumpReflectBinaryName, std::ios::binary | std::ios::ate);
+    if (in.fail())
+        Error("unable to open input file", dumpReflectBinaryName);
+    const std::streamoff size = in.tellg();
+    if (size < 0)
+        Error("unable to read input file", dumpReflectBinaryName);
+    if (size % sizeof(unsigned int) != 0)
+        Error("not a reflection binary: size is not a whole number of words", dumpReflectBinaryName);
+    std::vector<unsigned int> words((size_t)size / sizeof(unsigned int));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(unsigned int));
+    if (in.fail())
+        Error("unable to read input file", dumpReflectBinaryName);
+
+    glslang::TReflectionBinary reflection;
+    if (! reflection.init(words.data(), words.size() * sizeof(unsigned int)))
+        Error("not a reflection binary of this version", dumpReflectBinaryName);
+
+    static const char* sectionNames[glslang::EReflectionSectionCount] = {
+        "Uniform", "Uniform block", "Buffer variable", "Buffer block", "Pipeline input", "Pipeline output"
+    };
+    for (int s = 0; s < glslang::EReflectionSectionCount; ++s) {
+        const glslang::TReflectionBinarySection section = (glslang::TReflectionBinarySection)s;
+        printf("%s reflection:\n", sectionNames[s]);
+        for (int i = 0; i < reflection.getNumRecords(section); ++i) {
+            const glslang::TReflectionBinaryRecord& record = *reflection.getRecord(section, i);
+            printf("%s: offset %d, type %x, size %d, index %d, binding %d, stages %d", reflection.getName(record),
+                   record.offset, record.glDefineType, record.size, record.index, record.binding, record.stages);
+            if (record.counterIndex != -1)
+                printf(", counter %d", record.counterIndex);
+            if (record.numMembers != -1)
+                printf(", numMembers %d", record.numMembers);
+            if (record.arrayStride != 0)
+                printf(", arrayStride %d", record.arrayStride);
+            if (record.topLevelArrayStride != 0)
+                printf(", topLevelArrayStride %d", record.topLevelArrayStride);
+            printf("\n");
+        }
+        printf("\n");
+    }
+
+    if (reflection.getLocalSize(0) > 1) {
+        static const char* axis[] = { "X", "Y", "Z" };
+
+        for (int dim = 0; dim < 3; ++dim)
+            if (reflection.getLocalSize(dim) > 1)
+                printf("Local size %s: %u\n", axis[dim], reflection.getLocalSize(dim));
+
+        printf("\n");
+    }
+
+    return 0;
+}
+
 int C_DECL main(int argc, char* argv[])
 {
     ProcessArguments(WorkItems, argc, argv);
 
+    if (batchManifestName)
+        return BatchMain();
+
+    if (workerSocketName)
+        return WorkerMain();
+
+    if (dumpReflectBinaryName)
+        return DumpReflectionBinary();
+
     int ret = 0;
 
     // Loop over the entire init/finalize cycle to watch memory changes
@@ -1795,9 +2699,30 @@ int C_DECL main(int argc, char* argv[])
 //
 EShLanguage FindLanguage(const std::string& name, bool parseStageName)
 {
+    EShLanguage language;
+    bool isHlsl = false;
+    const bool found = DeduceLanguage(name, shaderStageName, parseStageName, language, isHlsl);
+    if (isHlsl)
+        Options |= EOptionReadHlsl;
+    if (! found)
+        usage();
+
+    return language;
+}
+
+//
+// The work of FindLanguage(), without touching global state, so batch jobs can
+// use it from worker threads.  'stageOverride', when non-null, is used instead
+// of the file name's extension.  Returns false if no stage can be deduced.
+//
+bool DeduceLanguage(const std::string& name, const char* stageOverride, bool parseStageName,
+                    EShLanguage& language, bool& isHlsl)
+{
+    language = EShLangVertex;
+
     std::string stageName;
-    if (shaderStageName)
-        stageName = shaderStageName;
+    if (stageOverride)
+        stageName = stageOverride;
     else if (parseStageName) {
         // Note: "first" extension means "first from the end", i.e.
         // if the file is named foo.vert.glsl, then "glsl" is first,
@@ -1809,49 +2734,48 @@ EShLanguage FindLanguage(const std::string& name, bool parseStageName)
         std::string firstExt = name.substr(firstExtStart + 1, std::string::npos);
         bool usesUnifiedExt = hasFirstExt && (firstExt == "glsl" || firstExt == "hlsl");
         if (usesUnifiedExt && firstExt == "hlsl")
-            Options |= EOptionReadHlsl;
+            isHlsl = true;
         if (hasFirstExt && !usesUnifiedExt)
             stageName = firstExt;
         else if (usesUnifiedExt && hasSecondExt)
             stageName = name.substr(secondExtStart + 1, firstExtStart - secondExtStart - 1);
-        else {
-            usage();
-            return EShLangVertex;
-        }
+        else
+            return false;
     } else
         stageName = name;
 
     if (stageName == "vert")
-        return EShLangVertex;
+        language = EShLangVertex;
     else if (stageName == "tesc")
-        return EShLangTessControl;
+        language = EShLangTessControl;
     else if (stageName == "tese")
-        return EShLangTessEvaluation;
+        language = EShLangTessEvaluation;
     else if (stageName == "geom")
-        return EShLangGeometry;
+        language = EShLangGeometry;
     else if (stageName == "frag")
-        return EShLangFragment;
+        language = EShLangFragment;
     else if (stageName == "comp")
-        return EShLangCompute;
+        language = EShLangCompute;
     else if (stageName == "rgen")
-        return EShLangRayGen;
+        language = EShLangRayGen;
     else if (stageName == "rint")
-        return EShLangIntersect;
+        language = EShLangIntersect;
     else if (stageName == "rahit")
-        return EShLangAnyHit;
+        language = EShLangAnyHit;
     else if (stageName == "rchit")
-        return EShLangClosestHit;
+        language = EShLangClosestHit;
     else if (stageName == "rmiss")
-        return EShLangMiss;
+        language = EShLangMiss;
     else if (stageName == "rcall")
-        return EShLangCallable;
+        language = EShLangCallable;
     else if (stageName == "mesh")
-        return EShLangMesh;
+        language = EShLangMesh;
     else if (stageName == "task")
-        return EShLangTask;
+        language = EShLangTask;
+    else
+        return false;
 
-    usage();
-    return EShLangVertex;
+    return true;
 }
 
 //
@@ -2002,10 +2926,26 @@ void usage()
            "  --absolute-path                   Prints absolute path for messages\n"
            "  --auto-sampled-textures           Removes sampler variables and converts\n"
            "                                    existing textures to sampled textures\n"
+           "  --batch <manifest>                compile every job of a JSON manifest in this\n"
+           "                                    process, on a pool of worker threads; other\n"
+           "                                    options apply to every job, and each job can\n"
+           "                                    give \"inputs\", \"stage\", \"defines\",\n"
+           "                                    \"target-env\", \"entry-point\", and \"output\"\n"
+           "  --batch-summary <file>            write the --batch summary (per-job status,\n"
+           "                                    time, and log) to <file> instead of stdout\n"
+           "  --batch-threads <count>           number of --batch worker threads; defaults\n"
+           "                                    to one per hardware thread\n"
            "  --client {vulkan<ver>|opengl<ver>} see -V and -G\n"
+           "  --counters                        print hot-path event counts of each shader,\n"
+           "                                    linked stage, and SPIR-V generation to\n"
+           "                                    stderr; requires a build with\n"
+           "                                    ENABLE_COUNTERS\n"
            "  --depfile <file>                  writes depfile for build systems\n"
            "  --dump-builtin-symbols            prints builtin symbol table prior each compile\n"
            "  -dumpfullversion | -dumpversion   print bare major.minor.patchlevel\n"
+           "  --fingerprint                     only preprocess, and print a hash of each\n"
+           "                                    shader's token stream for cache keys; it\n"
+           "                                    ignores comments, whitespace, and #line\n"
            "  --flatten-uniform-arrays | --fua  flatten uniform texture/sampler arrays to\n"
            "                                    scalars\n"
            "  --glsl-version {100 | 110 | 120 | 130 | 140 | 150 |\n"
@@ -2040,6 +2980,12 @@ void usage()
            "                                    inactive or active\n"
            "  --reflect-unwrap-io-blocks        unwrap input/output blocks the same as\n"
            "                                    uniform blocks\n"
+           "  --reflect-parallel-stages         reflect the linked stages concurrently\n"
+           "  --reflect-binary <file>           write the reflection to <file> in the\n"
+           "                                    binary layout of ReflectionBinary.h;\n"
+           "                                    requires -l\n"
+           "  --dump-reflect-binary <file>      print a --reflect-binary file the way -q\n"
+           "                                    prints reflection\n"
            "  --resource-set-binding [stage] name set binding\n"
            "                                    set descriptor set and binding for\n"
            "                                    individual resources\n"
@@ -2093,6 +3039,12 @@ void usage()
            "  --spirv-dis                       output standard-form disassembly; works only\n"
            "                                    when a SPIR-V generation option is also used\n"
            "  --spirv-val                       execute the SPIRV-Tools validator\n"
+           "  --spirv-val-concurrent            validate the unoptimized SPIR-V on a helper\n"
+           "                                    thread while the optimizer runs; add\n"
+           "                                    --spirv-val to also validate the optimized\n"
+           "                                    result\n"
+           "  --spirv-parallel-stages           generate the SPIR-V of each stage on a thread\n"
+           "                                    of its own; output is unchanged\n"
            "  --source-entrypoint <name>        the given shader source function is\n"
            "                                    renamed to be the <name> given in -e\n"
            "  --sep                             synonym for --source-entrypoint\n"
@@ -2115,6 +3067,11 @@ void usage()
            "  --vn <name>                       creates a C header file that contains a\n"
            "                                    uint32_t array named <name>\n"
            "                                    initialized with the shader binary code\n"
+           "  --worker <socket>                 serve compile jobs from local clients (see\n"
+           "                                    glslang/Public/CompileWorker.h) on the Unix\n"
+           "                                    socket <socket>, a process per connection;\n"
+           "                                    other options apply to every job, as with\n"
+           "                                    --batch\n"
            "  --no-link                         Only compile shader; do not link (GLSL-only)\n"
            "                                    NOTE: this option will set the export linkage\n"
            "                                          attribute on all functions\n");
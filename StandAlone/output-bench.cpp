@@ -0,0 +1,157 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//
+// Measures the SPIR-V file writers, OutputSpvBin() and OutputSpvHex(), on
+// multi-megabyte modules.  Each module size is written 'iterations' times in
+// each form, to files in 'directory', and the best time of each is reported.
+//
+// The modules are synthetic: a SPIR-V header followed by pseudo-random words.
+// Neither writer looks at what the words mean, only at how many there are.
+//
+//   glslang-output-bench [-n <iterations>] [-d <directory>] [megabytes...]
+//
+// Without sizes, modules of 1, 4, 16 and 64 megabytes are written.
+//
+
+#include "SPIRV/GlslangToSpv.h"
+#include "SPIRV/spirv.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<unsigned int> MakeModule(size_t megabytes)
+{
+    std::vector<unsigned int> spirv(megabytes * 1024 * 1024 / sizeof(unsigned int));
+
+    // xorshift32, so every run writes the same words
+    unsigned int state = 2463534242u;
+    for (unsigned int& word : spirv) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        word = state;
+    }
+    if (spirv.size() >= 5) {
+        spirv[0] = spv::MagicNumber;
+        spirv[1] = spv::Version;
+        spirv[2] = 0;
+        spirv[3] = 1000;
+        spirv[4] = 0;
+    }
+
+    return spirv;
+}
+
+// Best of 'iterations' runs of 'write', in seconds; negative if a write failed
+template<class TWrite>
+double BestTime(int iterations, TWrite write)
+{
+    double best = -1.0;
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        if (! write())
+            return -1.0;
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (best < 0.0 || seconds < best)
+            best = seconds;
+    }
+
+    return best;
+}
+
+void Usage()
+{
+    fprintf(stderr, "usage: glslang-output-bench [-n <iterations>] [-d <directory>] [megabytes...]\n");
+    exit(EXIT_FAILURE);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int iterations = 5;
+    std::string directory = ".";
+    std::vector<size_t> sizes;
+    for (int a = 1; a < argc; ++a) {
+        if (strcmp(argv[a], "-n") == 0 && a + 1 < argc)
+            iterations = atoi(argv[++a]);
+        else if (strcmp(argv[a], "-d") == 0 && a + 1 < argc)
+            directory = argv[++a];
+        else if (argv[a][0] == '-' || atoi(argv[a]) < 1)
+            Usage();
+        else
+            sizes.push_back((size_t)atoi(argv[a]));
+    }
+    if (iterations < 1)
+        Usage();
+    if (sizes.empty())
+        sizes = { 1, 4, 16, 64 };
+
+    const std::string binName = directory + "/glslang-output-bench.spv";
+    const std::string hexName = directory + "/glslang-output-bench.h";
+
+    bool succeeded = true;
+    printf("%8s %10s %10s %10s %10s\n", "MB", "bin ms", "bin MB/s", "hex ms", "hex MB/s");
+    for (const size_t megabytes : sizes) {
+        const std::vector<unsigned int> spirv = MakeModule(megabytes);
+
+        const double binTime = BestTime(iterations, [&]() { return glslang::OutputSpvBin(spirv, binName.c_str()); });
+        const double hexTime = BestTime(iterations, [&]() {
+            return glslang::OutputSpvHex(spirv, hexName.c_str(), "glslang_output_bench");
+        });
+        if (binTime < 0.0 || hexTime < 0.0) {
+            printf("%8zu failed\n", megabytes);
+            succeeded = false;
+            continue;
+        }
+
+        // rate of SPIR-V written, not of text produced
+        printf("%8zu %10.1f %10.0f %10.1f %10.0f\n", megabytes, binTime * 1000.0, megabytes / std::max(binTime, 1e-9),
+               hexTime * 1000.0, megabytes / std::max(hexTime, 1e-9));
+    }
+
+    remove(binName.c_str());
+    remove(hexName.c_str());
+
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
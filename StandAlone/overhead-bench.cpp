@@ -0,0 +1,288 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//
+// Measures the fixed cost of compiling a shader: for tiny shaders, such as blits
+// and clears, that is nearly all of the cost.  Each compile is split in the phases
+// a client goes through, timed separately:
+//
+//   create   TShader and TProgram construction, and their setup
+//   parse    TShader::parse(), including the per-compile built-ins
+//   link     TProgram::link()
+//   mapio    TProgram::mapIO()
+//   spirv    GlslangToSpv(), with its post-processing
+//   delete   TProgram and TShader destruction
+//
+// Without files, a built-in set of trivial shaders is measured.  Each shader is
+// compiled once untimed, to warm the shared built-in symbol tables, then
+// 'iterations' times timed.
+//
+//   glslang-overhead-bench [-n <iterations>] [file...]
+//
+
+#include "glslang/Public/ShaderLang.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "SPIRV/GlslangToSpv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct TBenchShader {
+    std::string name;
+    std::string text;
+    EShLanguage stage;
+};
+
+const TBenchShader BuiltInShaders[] = {
+    { "fullscreen.vert",
+      "#version 450\n"
+      "layout(location = 0) out vec2 uv;\n"
+      "void main()\n"
+      "{\n"
+      "    uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);\n"
+      "    gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);\n"
+      "}\n",
+      EShLangVertex },
+    { "blit.frag",
+      "#version 450\n"
+      "layout(binding = 0) uniform sampler2D source;\n"
+      "layout(location = 0) in vec2 uv;\n"
+      "layout(location = 0) out vec4 color;\n"
+      "void main()\n"
+      "{\n"
+      "    color = texture(source, uv);\n"
+      "}\n",
+      EShLangFragment },
+    { "clear.frag",
+      "#version 450\n"
+      "layout(push_constant) uniform Clear { vec4 value; } clear;\n"
+      "layout(location = 0) out vec4 color;\n"
+      "void main()\n"
+      "{\n"
+      "    color = clear.value;\n"
+      "}\n",
+      EShLangFragment },
+    { "copy.comp",
+      "#version 450\n"
+      "layout(local_size_x = 64) in;\n"
+      "layout(binding = 0) readonly buffer Source { uint source[]; };\n"
+      "layout(binding = 1) writeonly buffer Destination { uint destination[]; };\n"
+      "void main()\n"
+      "{\n"
+      "    destination[gl_GlobalInvocationID.x] = source[gl_GlobalInvocationID.x];\n"
+      "}\n",
+      EShLangCompute },
+};
+
+enum TPhase {
+    EPhaseCreate,
+    EPhaseParse,
+    EPhaseLink,
+    EPhaseMapIO,
+    EPhaseSpirv,
+    EPhaseDelete,
+    EPhaseCount
+};
+
+const char* const PhaseNames[EPhaseCount] = { "create", "parse", "link", "mapio", "spirv", "delete" };
+
+bool GetStage(const std::string& name, EShLanguage& stage)
+{
+    static const struct {
+        const char* extension;
+        EShLanguage stage;
+    } stages[] = {
+        { "vert", EShLangVertex },       { "tesc", EShLangTessControl },
+        { "tese", EShLangTessEvaluation }, { "geom", EShLangGeometry },
+        { "frag", EShLangFragment },     { "comp", EShLangCompute },
+        { "rgen", EShLangRayGen },       { "rint", EShLangIntersect },
+        { "rahit", EShLangAnyHit },      { "rchit", EShLangClosestHit },
+        { "rmiss", EShLangMiss },        { "rcall", EShLangCallable },
+        { "task", EShLangTask },         { "mesh", EShLangMesh },
+    };
+
+    const size_t dot = name.rfind('.');
+    if (dot == std::string::npos)
+        return false;
+    for (const auto& entry : stages) {
+        if (name.compare(dot + 1, std::string::npos, entry.extension) == 0) {
+            stage = entry.stage;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+double Microseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// Compile 'benchShader' for Vulkan 1.0, as -V does, adding the time of each phase to 'times'.
+bool Compile(const TBenchShader& benchShader, double times[EPhaseCount], size_t& wordCount)
+{
+    const EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
+
+    auto start = std::chrono::steady_clock::now();
+    glslang::TShader* shader = new glslang::TShader(benchShader.stage);
+    const char* text = benchShader.text.c_str();
+    shader->setStrings(&text, 1);
+    shader->setEnvInput(glslang::EShSourceGlsl, benchShader.stage, glslang::EShClientVulkan, 100);
+    shader->setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader->setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    glslang::TProgram* program = new glslang::TProgram;
+    auto end = std::chrono::steady_clock::now();
+    times[EPhaseCreate] += Microseconds(start, end);
+
+    start = end;
+    bool succeeded = shader->parse(GetDefaultResources(), 100, false, messages);
+    end = std::chrono::steady_clock::now();
+    times[EPhaseParse] += Microseconds(start, end);
+
+    if (succeeded) {
+        start = end;
+        program->addShader(shader);
+        succeeded = program->link(messages);
+        end = std::chrono::steady_clock::now();
+        times[EPhaseLink] += Microseconds(start, end);
+    }
+
+    if (succeeded) {
+        start = end;
+        succeeded = program->mapIO();
+        end = std::chrono::steady_clock::now();
+        times[EPhaseMapIO] += Microseconds(start, end);
+    }
+
+    if (succeeded) {
+        start = end;
+        std::vector<unsigned int> spirv;
+        spv::SpvBuildLogger logger;
+        glslang::SpvOptions options;
+        glslang::GlslangToSpv(*program->getIntermediate(benchShader.stage), spirv, &logger, &options);
+        end = std::chrono::steady_clock::now();
+        times[EPhaseSpirv] += Microseconds(start, end);
+        wordCount = spirv.size();
+    } else {
+        fprintf(stderr, "%s: %s%s", benchShader.name.c_str(), shader->getInfoLog(), program->getInfoLog());
+    }
+
+    start = end;
+    delete program;
+    delete shader;
+    times[EPhaseDelete] += Microseconds(start, std::chrono::steady_clock::now());
+
+    return succeeded;
+}
+
+void Usage()
+{
+    fprintf(stderr, "usage: glslang-overhead-bench [-n <iterations>] [file...]\n");
+    exit(EXIT_FAILURE);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int iterations = 1000;
+    std::vector<TBenchShader> shaders;
+    for (int a = 1; a < argc; ++a) {
+        if (strcmp(argv[a], "-n") == 0 && a + 1 < argc)
+            iterations = atoi(argv[++a]);
+        else if (argv[a][0] == '-')
+            Usage();
+        else {
+            TBenchShader shader;
+            shader.name = argv[a];
+            std::ifstream stream(shader.name, std::ios_base::binary);
+            if (! stream || ! GetStage(shader.name, shader.stage)) {
+                fprintf(stderr, "%s: cannot read, or no stage for, the file\n", argv[a]);
+                return EXIT_FAILURE;
+            }
+            std::ostringstream buffer;
+            buffer << stream.rdbuf();
+            shader.text = buffer.str();
+            shaders.push_back(shader);
+        }
+    }
+    if (iterations < 1)
+        Usage();
+    if (shaders.empty())
+        shaders.assign(std::begin(BuiltInShaders), std::end(BuiltInShaders));
+
+    glslang::InitializeProcess();
+
+    bool succeeded = true;
+    printf("%-24s", "us per compile");
+    for (int phase = 0; phase < EPhaseCount; ++phase)
+        printf(" %9s", PhaseNames[phase]);
+    printf(" %9s %7s\n", "total", "words");
+    for (const TBenchShader& shader : shaders) {
+        double warmTimes[EPhaseCount] = {};
+        double times[EPhaseCount] = {};
+        size_t wordCount = 0;
+        bool compiled = Compile(shader, warmTimes, wordCount);
+        for (int i = 0; i < iterations && compiled; ++i)
+            compiled = Compile(shader, times, wordCount);
+        succeeded = succeeded && compiled;
+        if (! compiled) {
+            printf("%-24s failed\n", shader.name.c_str());
+            continue;
+        }
+
+        double total = 0.0;
+        printf("%-24s", shader.name.c_str());
+        for (int phase = 0; phase < EPhaseCount; ++phase) {
+            printf(" %9.1f", times[phase] / iterations);
+            total += times[phase] / iterations;
+        }
+        printf(" %9.1f %7zu\n", total, wordCount);
+    }
+
+    glslang::FinalizeProcess();
+
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -150,12 +150,9 @@ namespace {
         if (fp.fail())
             errHandler(std::string("error opening file for write: ") + outFile);
 
-        for (auto it = spv.cbegin(); it != spv.cend(); ++it) {
-            SpvWord word = *it;
-            fp.write((char *)&word, sizeof(word));
-            if (fp.fail())
-                errHandler(std::string("error writing file: ") + outFile);
-        }
+        fp.write((const char *)spv.data(), spv.size() * sizeof(SpvWord));
+        if (fp.fail())
+            errHandler(std::string("error writing file: ") + outFile);
 
         // file is closed by destructor
     }
@@ -0,0 +1,332 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//
+// Compares compiling shaders through a --worker against compiling them in this
+// process through the C interface.  Start the worker with -V, which is what the
+// in-process compiles do:
+//
+//   glslang -V --worker /tmp/glslang.sock &
+//   glslang-worker-bench -n 100 /tmp/glslang.sock shader.frag ...
+//
+// Each side compiles every file once untimed, to warm its built-in symbol tables,
+// then 'iterations' times timed.  With --check, the exit code says whether both
+// sides succeeded and produced the same SPIR-V.
+//
+// The worker's handling of faults is checked, before the timing, by:
+//
+//   --ring-size <bytes>  sharing a ring of that size; results that do not fit come inline
+//   --check-bad-jobs     sending an empty and a malformed job, which must come back as
+//                        bad jobs on a connection that then still compiles
+//   --check-reconnect    after the first compile, printing "ready" and waiting for a line
+//                        on stdin, while the caller kills the connection's process; the
+//                        next compile must fail, and compile again once reconnected
+//
+
+#include "glslang/Include/glslang_c_interface.h"
+#include "glslang/Public/resource_limits_c.h"
+#include "glslang/Public/CompileWorker.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct TBenchFile {
+    std::string name;
+    std::string text;
+    glslang_stage_t stage;
+};
+
+bool GetStage(const std::string& name, glslang_stage_t& stage)
+{
+    static const struct {
+        const char* extension;
+        glslang_stage_t stage;
+    } stages[] = {
+        { "vert", GLSLANG_STAGE_VERTEX },       { "tesc", GLSLANG_STAGE_TESSCONTROL },
+        { "tese", GLSLANG_STAGE_TESSEVALUATION }, { "geom", GLSLANG_STAGE_GEOMETRY },
+        { "frag", GLSLANG_STAGE_FRAGMENT },     { "comp", GLSLANG_STAGE_COMPUTE },
+        { "rgen", GLSLANG_STAGE_RAYGEN },       { "rint", GLSLANG_STAGE_INTERSECT },
+        { "rahit", GLSLANG_STAGE_ANYHIT },      { "rchit", GLSLANG_STAGE_CLOSESTHIT },
+        { "rmiss", GLSLANG_STAGE_MISS },        { "rcall", GLSLANG_STAGE_CALLABLE },
+        { "task", GLSLANG_STAGE_TASK },         { "mesh", GLSLANG_STAGE_MESH },
+    };
+
+    const size_t dot = name.rfind('.');
+    if (dot == std::string::npos)
+        return false;
+    for (const auto& entry : stages) {
+        if (name.compare(dot + 1, std::string::npos, entry.extension) == 0) {
+            stage = entry.stage;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Compile and link 'file' for Vulkan 1.0 through the C interface, as -V does.
+bool CompileInProcess(const TBenchFile& file, std::vector<unsigned int>& spirv)
+{
+    glslang_input_t input = {};
+    input.language = GLSLANG_SOURCE_GLSL;
+    input.stage = file.stage;
+    input.client = GLSLANG_CLIENT_VULKAN;
+    input.client_version = GLSLANG_TARGET_VULKAN_1_0;
+    input.target_language = GLSLANG_TARGET_SPV;
+    input.target_language_version = GLSLANG_TARGET_SPV_1_0;
+    input.code = file.text.c_str();
+    input.default_version = 100;
+    input.default_profile = GLSLANG_NO_PROFILE;
+    input.messages = (glslang_messages_t)(GLSLANG_MSG_SPV_RULES_BIT | GLSLANG_MSG_VULKAN_RULES_BIT);
+    input.resource = glslang_default_resource();
+
+    glslang_shader_t* shader = glslang_shader_create(&input);
+    glslang_program_t* program = glslang_program_create();
+    bool succeeded = glslang_shader_preprocess(shader, &input) && glslang_shader_parse(shader, &input);
+    if (succeeded) {
+        glslang_program_add_shader(program, shader);
+        succeeded = glslang_program_link(program, input.messages) && glslang_program_map_io(program);
+    }
+    if (succeeded) {
+        glslang_program_SPIRV_generate(program, file.stage);
+        spirv.resize(glslang_program_SPIRV_get_size(program));
+        glslang_program_SPIRV_get(program, spirv.data());
+    }
+    glslang_program_delete(program);
+    glslang_shader_delete(shader);
+
+    return succeeded;
+}
+
+// Can send payloads that are not serialized jobs
+class TBenchClient : public glslang::TCompileWorkerClient {
+public:
+    using glslang::TCompileWorkerClient::compilePayload;
+};
+
+bool CompileInWorker(glslang::TCompileWorkerClient& client, const TBenchFile& file, std::vector<unsigned int>& spirv)
+{
+    glslang::TCompileWorkerJob job;
+    job.sources.push_back({ file.name, file.text });
+    glslang::TCompileWorkerResult result;
+    const bool succeeded = client.compile(job, result) && result.succeeded() && result.modules.size() == 1;
+    if (succeeded)
+        spirv.assign(result.modules[0].words, result.modules[0].words + result.modules[0].wordCount);
+    client.release(result);
+
+    return succeeded;
+}
+
+// An empty job, and one cut off in its first source, are each answered as a bad job, and
+// the connection still compiles 'file' afterwards.
+bool CheckBadJobs(TBenchClient& client, const TBenchFile& file)
+{
+    std::string truncated;
+    glslang::TCompileWorkerJob job;
+    job.sources.push_back({ file.name, file.text });
+    job.serialize(truncated);
+    truncated.resize(truncated.size() / 2);
+
+    glslang::TCompileWorkerResult result;
+    bool succeeded = client.compile(glslang::TCompileWorkerJob(), result) &&
+                     result.status == glslang::ECompileWorkerBadJob && result.modules.empty();
+    client.release(result);
+    if (! succeeded) {
+        fprintf(stderr, "an empty job is not answered as a bad job\n");
+        return false;
+    }
+
+    succeeded = client.compilePayload(truncated, result) && result.status == glslang::ECompileWorkerBadJob &&
+                result.getLog() == "malformed job\n";
+    client.release(result);
+    if (! succeeded) {
+        fprintf(stderr, "a malformed job is not answered as a bad job\n");
+        return false;
+    }
+
+    std::vector<unsigned int> spirv;
+    if (! CompileInWorker(client, file, spirv)) {
+        fprintf(stderr, "%s: does not compile after the bad jobs\n", file.name.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// Compiles 'file', then waits while the caller kills the process serving the connection,
+// then checks that the next compile fails with the connection gone, and that a new
+// connection compiles 'file' to the same SPIR-V.
+bool CheckReconnect(TBenchClient& client, const char* socketName, size_t ringSize, const TBenchFile& file)
+{
+    std::vector<unsigned int> before;
+    if (! CompileInWorker(client, file, before)) {
+        fprintf(stderr, "%s: does not compile before the reconnect\n", file.name.c_str());
+        return false;
+    }
+
+    printf("ready\n");
+    fflush(stdout);
+    char line[16];
+    if (fgets(line, sizeof(line), stdin) == nullptr) {
+        fprintf(stderr, "no line on stdin to go on with\n");
+        return false;
+    }
+
+    glslang::TCompileWorkerJob job;
+    job.sources.push_back({ file.name, file.text });
+    glslang::TCompileWorkerResult result;
+    if (client.compile(job, result) || client.connected() || result.status != glslang::ECompileWorkerNoConnection) {
+        fprintf(stderr, "a compile on a connection whose process was killed does not fail\n");
+        return false;
+    }
+
+    std::vector<unsigned int> after;
+    if (! client.connect(socketName, ringSize) || ! CompileInWorker(client, file, after) || after != before) {
+        fprintf(stderr, "%s: does not compile the same after the reconnect\n", file.name.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+double Milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Usage()
+{
+    fprintf(stderr, "usage: glslang-worker-bench [-n <iterations>] [--check] [--ring-size <bytes>]\n"
+                    "                            [--check-bad-jobs] [--check-reconnect] <socket> <file>...\n");
+    exit(EXIT_FAILURE);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int iterations = 10;
+    bool check = false;
+    bool checkBadJobs = false;
+    bool checkReconnect = false;
+    size_t ringSize = glslang::TCompileWorkerClient::DefaultRingSize;
+    const char* socketName = nullptr;
+    std::vector<TBenchFile> files;
+    for (int a = 1; a < argc; ++a) {
+        if (strcmp(argv[a], "-n") == 0 && a + 1 < argc)
+            iterations = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--check") == 0)
+            check = true;
+        else if (strcmp(argv[a], "--ring-size") == 0 && a + 1 < argc)
+            ringSize = (size_t)strtoull(argv[++a], nullptr, 10);
+        else if (strcmp(argv[a], "--check-bad-jobs") == 0)
+            checkBadJobs = true;
+        else if (strcmp(argv[a], "--check-reconnect") == 0)
+            checkReconnect = true;
+        else if (argv[a][0] == '-')
+            Usage();
+        else if (socketName == nullptr)
+            socketName = argv[a];
+        else {
+            TBenchFile file;
+            file.name = argv[a];
+            std::ifstream stream(file.name, std::ios_base::binary);
+            if (! stream || ! GetStage(file.name, file.stage)) {
+                fprintf(stderr, "%s: cannot read, or no stage for, the file\n", argv[a]);
+                return EXIT_FAILURE;
+            }
+            std::ostringstream buffer;
+            buffer << stream.rdbuf();
+            file.text = buffer.str();
+            files.push_back(file);
+        }
+    }
+    if (socketName == nullptr || files.empty() || iterations < 1 || ringSize == 0)
+        Usage();
+
+    TBenchClient client;
+    if (! client.connect(socketName, ringSize)) {
+        fprintf(stderr, "%s: cannot connect to a worker\n", socketName);
+        return EXIT_FAILURE;
+    }
+    if ((checkBadJobs && ! CheckBadJobs(client, files.front())) ||
+        (checkReconnect && ! CheckReconnect(client, socketName, ringSize, files.front())))
+        return EXIT_FAILURE;
+    glslang_initialize_process();
+
+    bool allMatch = true;
+    double inProcessTotal = 0.0;
+    double workerTotal = 0.0;
+    printf("%-40s %14s %14s %8s  %s\n", "file", "in-process ms", "worker ms", "words", "same");
+    for (const TBenchFile& file : files) {
+        std::vector<unsigned int> inProcess;
+        std::vector<unsigned int> worker;
+        bool succeeded = CompileInProcess(file, inProcess) && CompileInWorker(client, file, worker);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations && succeeded; ++i)
+            succeeded = CompileInProcess(file, inProcess);
+        const double inProcessMs = Milliseconds(start) / iterations;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations && succeeded; ++i)
+            succeeded = CompileInWorker(client, file, worker);
+        const double workerMs = Milliseconds(start) / iterations;
+
+        const bool same = succeeded && inProcess == worker;
+        allMatch = allMatch && same;
+        inProcessTotal += inProcessMs;
+        workerTotal += workerMs;
+        if (succeeded)
+            printf("%-40s %14.3f %14.3f %8zu  %s\n", file.name.c_str(), inProcessMs, workerMs, worker.size(),
+                   same ? "yes" : "no");
+        else
+            printf("%-40s %14s %14s %8s  %s\n", file.name.c_str(), "-", "-", "-", "failed");
+    }
+    printf("%-40s %14.3f %14.3f\n", "total", inProcessTotal, workerTotal);
+
+    glslang_finalize_process();
+
+    return check && ! allMatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
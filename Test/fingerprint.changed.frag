@@ -0,0 +1,6 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+#define SCALE 16.0
+vec4 getColor() { return vec4(1.0, 0.5, 0.25, 1); }
+layout(location = 0) out vec4 color;
+void main() { color = getColor() * SCALE + 1.0; }
@@ -0,0 +1,11 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include "fingerprint.included.glsl"
+
+layout(location=0) out vec4 color;
+
+void main()
+{
+    color = getColor() * SCALE;
+}
@@ -0,0 +1,6 @@
+#define SCALE 16.0
+
+vec4 getColor()
+{
+    return vec4(1.0, 0.5, 0.25, 1);
+}
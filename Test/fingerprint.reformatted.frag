@@ -0,0 +1,8 @@
+#version 450 core
+// The same tokens as fingerprint.frag, with its include expanded by hand
+#extension GL_GOOGLE_include_directive : require
+#define SCALE 1.6e1
+vec4 getColor() { return vec4(1.0, .5, 0.250, 0x1); }   /* hex, and a comment */
+#line 20
+layout(location = 0) out vec4 color;
+void main() { color = getColor()*SCALE; }
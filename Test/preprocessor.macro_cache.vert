@@ -0,0 +1,82 @@
+#version 310 es
+
+// Object-like macros are expanded once and replayed; every case here uses
+// each macro more than once, so the replayed expansion is checked too.
+
+// Redefining or undefining a macro an expansion looked up drops that expansion
+#define INNER 1
+#define OUTER (INNER + 2)
+int a0 = OUTER;
+int a1 = OUTER;
+#undef INNER
+#define INNER 10
+int a2 = OUTER;
+int a3 = OUTER;
+#undef INNER
+int a4 = OUTER;
+int a5 = OUTER;
+#define INNER 100
+int a6 = OUTER;
+
+// Identifiers looked up but not defined yet
+#define LATE LATE_VALUE * 2
+int b0 = LATE;
+#define LATE_VALUE 7
+int b1 = LATE;
+int b2 = LATE;
+
+// Mutual recursion stops at the busy macro, in either order
+#define PING PONG + 1
+#define PONG PING + 2
+int c0 = PING;
+int c1 = PONG;
+int c2 = PING;
+int c3 = PONG;
+
+// Token pasting in an object-like body
+#define PASTE_BODY a ## 0
+int d0 = PASTE_BODY;
+int d1 = PASTE_BODY;
+
+// Token pasting of object-like macros passed as arguments
+#define CAT(x, y) x ## y
+#define LEFT b
+#define RIGHT 1
+int d2 = CAT(LEFT, RIGHT);
+int d3 = CAT(LEFT, RIGHT);
+#define XCAT(x, y) CAT(x, y)
+int d4 = XCAT(LEFT, RIGHT);
+int d5 = XCAT(LEFT, RIGHT);
+
+// __LINE__ is never replayed
+#define HERE __LINE__
+#define HERE_TOO (HERE + 0)
+int e0 = HERE;
+int e1 = HERE;
+int e2 = HERE_TOO;
+
+int e3 = HERE_TOO;
+
+// A function-like macro named at the end of a body takes its arguments
+// from after the object-like macro
+#define TWICE(x) ((x) * 2)
+#define CALLER TWICE
+int f0 = CALLER(3);
+int f1 = CALLER(4);
+int f2 = CALLER;
+#define CALL_OUTER CALLER
+int f3 = CALL_OUTER(5);
+int f4 = CALL_OUTER(6);
+
+// Inside #if the expansion is evaluated, not replayed
+#define LIMIT INNER
+#if LIMIT == 100
+int g0 = LIMIT;
+#endif
+#undef INNER
+#define INNER 5
+#if LIMIT == 5
+int g1 = LIMIT;
+#endif
+
+void main() {}
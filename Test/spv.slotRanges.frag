@@ -0,0 +1,27 @@
+#version 450
+
+// OpenGL takes a binding per array element, so large arrays stress the auto-mapped
+// slot ranges: overlapping explicit bindings, and first-fit gaps among them
+
+layout(binding = 3) uniform sampler2D pinned[4096];
+uniform sampler2D textures[16384];
+uniform sampler2D small;
+uniform sampler2D pair[2];
+layout(binding = 4098) uniform sampler2D aliased[8];
+uniform sampler2D gapFiller[16];
+
+layout(binding = 0, rgba8) uniform image2D images[8192];
+layout(binding = 10000, rgba8) uniform image2D farImages[100];
+layout(rgba8) uniform image2D moreImages[1800];
+layout(rgba8) uniform image2D lastImages[10];
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+    int i = int(gl_FragCoord.x);
+    color = texture(pinned[i], vec2(0)) + texture(textures[i], vec2(0)) + texture(small, vec2(0)) +
+            texture(pair[i], vec2(0)) + texture(aliased[i], vec2(0)) + texture(gapFiller[i], vec2(0)) +
+            imageLoad(images[i], ivec2(0)) + imageLoad(farImages[i], ivec2(0)) +
+            imageLoad(moreImages[i], ivec2(0)) + imageLoad(lastImages[i], ivec2(0));
+}
@@ -0,0 +1,33 @@
+#version 450
+
+// many sets, each with explicit and auto-mapped bindings
+
+layout(set = 0, binding = 1) uniform sampler2D s0[16384];
+layout(set = 0) uniform sampler2D a0;
+layout(set = 1, binding = 0) uniform sampler2D s1[100];
+layout(set = 1) uniform sampler2D a1[2];
+layout(set = 1) uniform sampler2D b1;
+layout(set = 2, binding = 2) uniform sampler2D s2;
+layout(set = 2) uniform sampler2D a2;
+layout(set = 2) uniform sampler2D b2;
+layout(set = 2) uniform sampler2D c2;
+layout(set = 3, binding = 0) uniform sampler2D s3;
+layout(set = 3, binding = 0) uniform sampler2D aliased3;
+layout(set = 3) uniform sampler2D a3;
+layout(set = 4) uniform sampler2D a4[4096];
+layout(set = 5) uniform sampler2D a5[8];
+layout(set = 6, binding = 7) uniform sampler2D s6;
+layout(set = 7, binding = 0) uniform sampler2D s7;
+layout(set = 7) uniform sampler2D a7;
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+    int i = int(gl_FragCoord.x);
+    color = texture(s0[i], vec2(0)) + texture(a0, vec2(0)) + texture(s1[i], vec2(0)) + texture(a1[i], vec2(0)) +
+            texture(b1, vec2(0)) + texture(s2, vec2(0)) + texture(a2, vec2(0)) + texture(b2, vec2(0)) +
+            texture(c2, vec2(0)) + texture(s3, vec2(0)) + texture(aliased3, vec2(0)) + texture(a3, vec2(0)) +
+            texture(a4[i], vec2(0)) + texture(a5[i], vec2(0)) + texture(s6, vec2(0)) + texture(s7, vec2(0)) +
+            texture(a7, vec2(0));
+}
@@ -408,10 +408,33 @@ GLSLANG_EXPORT int glslang_shader_preprocess(glslang_shader_t* shader, const gls
     );
 }
 
+GLSLANG_EXPORT int glslang_shader_fingerprint(glslang_shader_t* shader, const glslang_input_t* input,
+                                              unsigned long long* fingerprint)
+{
+    DirStackFileIncluder dirStackFileIncluder;
+    CallbackIncluder callbackIncluder(input->callbacks, input->callbacks_ctx);
+    glslang::TShader::Includer& Includer = (input->callbacks.include_local||input->callbacks.include_system)
+        ? static_cast<glslang::TShader::Includer&>(callbackIncluder)
+        : static_cast<glslang::TShader::Includer&>(dirStackFileIncluder);
+    return shader->shader->fingerprint(
+        reinterpret_cast<const TBuiltInResource*>(input->resource),
+        input->default_version,
+        c_shader_profile(input->default_profile),
+        input->force_default_version_and_profile != 0,
+        input->forward_compatible != 0,
+        (EShMessages)c_shader_messages(input->messages),
+        fingerprint,
+        Includer
+    );
+}
+
 GLSLANG_EXPORT int glslang_shader_parse(glslang_shader_t* shader, const glslang_input_t* input)
 {
+    // What is parsed is this wrapper's own preprocessed text, not input->code, and it stays
+    // until glslang_shader_delete(), so the shader can keep it as source text without a copy.
     const char* preprocessedCStr = shader->preprocessedGLSL.c_str();
     shader->shader->setStrings(&preprocessedCStr, 1);
+    shader->shader->setStringsRetained(true);
 
     return shader->shader->parse(
         reinterpret_cast<const TBuiltInResource*>(input->resource),
@@ -4394,10 +4394,20 @@ bool HlslGrammar::acceptPostDecls(TQualifier& qualifier)
                 }
                 parseContext.handleRegister(registerDesc.loc, qualifier, profile.string, *registerDesc.string, subComponent, spaceDesc.string);
             } else {
-                // semantic, in idToken.string
-                TString semanticUpperCase = *idToken.string;
-                std::transform(semanticUpperCase.begin(), semanticUpperCase.end(), semanticUpperCase.begin(), ::toupper);
-                parseContext.handleSemantic(idToken.loc, qualifier, mapSemantic(semanticUpperCase.c_str()), semanticUpperCase);
+                // semantic, in idToken.string; matched ignoring case, but recorded in upper case,
+                // so only a semantic that is not in the table and not already upper case is copied
+                const char* semanticUpperCase;
+                const TBuiltInVariable builtIn = mapSemantic(idToken.string->c_str(), semanticUpperCase);
+                TString upperCaseCopy;
+                if (semanticUpperCase == nullptr) {
+                    semanticUpperCase = idToken.string->c_str();
+                    if (std::any_of(idToken.string->begin(), idToken.string->end(), ::islower)) {
+                        upperCaseCopy = *idToken.string;
+                        std::transform(upperCaseCopy.begin(), upperCaseCopy.end(), upperCaseCopy.begin(), ::toupper);
+                        semanticUpperCase = upperCaseCopy.c_str();
+                    }
+                }
+                parseContext.handleSemantic(idToken.loc, qualifier, builtIn, semanticUpperCase);
             }
         } else if (peekTokenClass(EHTokLeftAngle)) {
             found = true;
@@ -48,6 +48,7 @@
 #include <algorithm>
 #include <functional>
 #include <cctype>
+#include <cstring>
 #include <array>
 #include <set>
 
@@ -6216,21 +6217,23 @@ TFunction* HlslParseContext::makeConstructorCall(const TSourceLoc& loc, const TT
 // by updating the type according to the semantic.
 //
 void HlslParseContext::handleSemantic(TSourceLoc loc, TQualifier& qualifier, TBuiltInVariable builtIn,
-                                      const TString& upperCase)
+                                      const char* upperCase)
 {
     // Parse and return semantic number.  If limit is 0, it will be ignored.  Otherwise, if the parsed
     // semantic number is >= limit, errorMsg is issued and 0 is returned.
     // TODO: it would be nicer if limit and errorMsg had default parameters, but some compilers don't yet
     // accept those in lambda functions.
-    const auto getSemanticNumber = [this, loc](const TString& semantic, unsigned int limit, const char* errorMsg) -> unsigned int {
-        size_t pos = semantic.find_last_not_of("0123456789");
-        if (pos == std::string::npos)
+    const auto getSemanticNumber = [this, loc](const char* semantic, unsigned int limit, const char* errorMsg) -> unsigned int {
+        const char* digits = semantic + strlen(semantic);
+        while (digits > semantic && isdigit((unsigned char)digits[-1]))
+            --digits;
+        if (digits == semantic)
             return 0u;
 
-        unsigned int semanticNum = (unsigned int)atoi(semantic.c_str() + pos + 1);
+        unsigned int semanticNum = (unsigned int)atoi(digits);
 
         if (limit != 0 && semanticNum >= limit) {
-            error(loc, errorMsg, semantic.c_str(), "");
+            error(loc, errorMsg, semantic, "");
             return 0u;
         }
 
@@ -6240,23 +6243,23 @@ void HlslParseContext::handleSemantic(TSourceLoc loc, TQualifier& qualifier, TBu
     if (builtIn == EbvNone && hlslDX9Compatible()) {
         if (language == EShLangVertex) {
             if (qualifier.isParamOutput()) {
-                if (upperCase == "POSITION") {
+                if (strcmp(upperCase, "POSITION") == 0) {
                     builtIn = EbvPosition;
                 }
-                if (upperCase == "PSIZE") {
+                if (strcmp(upperCase, "PSIZE") == 0) {
                     builtIn = EbvPointSize;
                 }
             }
         } else if (language == EShLangFragment) {
-            if (qualifier.isParamInput() && upperCase == "VPOS") {
+            if (qualifier.isParamInput() && strcmp(upperCase, "VPOS") == 0) {
                 builtIn = EbvFragCoord;
             }
             if (qualifier.isParamOutput()) {
-                if (upperCase.compare(0, 5, "COLOR") == 0) {
+                if (strncmp(upperCase, "COLOR", 5) == 0) {
                     qualifier.layoutLocation = getSemanticNumber(upperCase, 0, nullptr);
                     nextOutLocation = std::max(nextOutLocation, qualifier.layoutLocation + 1u);
                 }
-                if (upperCase == "DEPTH") {
+                if (strcmp(upperCase, "DEPTH") == 0) {
                     builtIn = EbvFragDepth;
                 }
             }
@@ -6267,13 +6270,13 @@ void HlslParseContext::handleSemantic(TSourceLoc loc, TQualifier& qualifier, TBu
     case EbvNone:
         // Get location numbers from fragment outputs, instead of
         // auto-assigning them.
-        if (language == EShLangFragment && upperCase.compare(0, 9, "SV_TARGET") == 0) {
+        if (language == EShLangFragment && strncmp(upperCase, "SV_TARGET", 9) == 0) {
             qualifier.layoutLocation = getSemanticNumber(upperCase, 0, nullptr);
             nextOutLocation = std::max(nextOutLocation, qualifier.layoutLocation + 1u);
-        } else if (upperCase.compare(0, 15, "SV_CLIPDISTANCE") == 0) {
+        } else if (strncmp(upperCase, "SV_CLIPDISTANCE", 15) == 0) {
             builtIn = EbvClipDistance;
             qualifier.layoutLocation = getSemanticNumber(upperCase, maxClipCullRegs, "invalid clip semantic");
-        } else if (upperCase.compare(0, 15, "SV_CULLDISTANCE") == 0) {
+        } else if (strncmp(upperCase, "SV_CULLDISTANCE", 15) == 0) {
             builtIn = EbvCullDistance;
             qualifier.layoutLocation = getSemanticNumber(upperCase, maxClipCullRegs, "invalid cull semantic");
         }
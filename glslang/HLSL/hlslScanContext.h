@@ -77,11 +77,8 @@ public:
         : parseContext(parseContext), ppContext(ppContext) { }
     virtual ~HlslScanContext() { }
 
-    static void fillInKeywordMap();
-    static void deleteKeywordMap();
-
     void tokenize(HlslToken&);
-    glslang::TBuiltInVariable mapSemantic(const char*);
+    glslang::TBuiltInVariable mapSemantic(const char*, const char*& upperCase);
 
 protected:
     HlslScanContext(HlslScanContext&);
@@ -52,7 +52,10 @@ namespace glslang {
         bool acceptTokenClass(EHlslTokenClass);
         EHlslTokenClass peek() const;
         bool peekTokenClass(EHlslTokenClass) const;
-        glslang::TBuiltInVariable mapSemantic(const char* upperCase) { return scanner.mapSemantic(upperCase); }
+        glslang::TBuiltInVariable mapSemantic(const char* semantic, const char*& upperCase)
+        {
+            return scanner.mapSemantic(semantic, upperCase);
+        }
 
         void pushTokenStream(const TVector<HlslToken>* tokens);
         void popTokenStream();
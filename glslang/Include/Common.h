@@ -227,30 +227,57 @@ inline const TString String(const int i, const int /*base*/ = 10)
 }
 #endif
 
+//
+// The names of source strings, so that a TSourceLoc can refer to its name with a small
+// index instead of a pointer.  Index 0 is no name.  Each compile holds the names it refers
+// to in its own TSourceNames; a name, and its index, stay until no compile holds it.
+//
+class TSourceNames {
+public:
+    TSourceNames() {}
+    ~TSourceNames();
+
+    // Returns the index of 'name', or 0 for nullptr, holding the name for this compile.
+    int getIndex(const char* name);
+
+private:
+    TSourceNames(const TSourceNames&);
+    TSourceNames& operator=(const TSourceNames&);
+
+    std::unordered_map<std::string, int> indices;  // the names this compile holds
+};
+
+// Resolves the index of a name some compile still holds; nullptr once none does, so a
+// TSourceLoc that outlives its compile falls back to its string number.
+const char* GetSourceName(int nameIndex);
+void ReleaseSourceNames();
+
 struct TSourceLoc {
     void init()
     {
-        name = nullptr; string = 0; line = 0; column = 0;
+        nameIndex = 0; string = 0; line = 0; column = 0;
     }
     void init(int stringNum) { init(); string = stringNum; }
     // Returns the name if it exists. Otherwise, returns the string number.
     std::string getStringNameOrNum(bool quoteStringName = true) const
     {
-        if (name != nullptr) {
-            TString qstr = quoteStringName ? ("\"" + *name + "\"") : *name;
-            std::string ret_str(qstr.c_str());
-            return ret_str;
-        }
+        const char* name = getFilename();
+        if (name != nullptr)
+            return quoteStringName ? "\"" + std::string(name) + "\"" : std::string(name);
         return std::to_string((long long)string);
     }
     const char* getFilename() const
     {
-        if (name == nullptr)
+        if (nameIndex == 0)
             return nullptr;
-        return name->c_str();
+        return GetSourceName(nameIndex);
+    }
+    const char* getFilenameStr() const
+    {
+        const char* name = getFilename();
+        return name == nullptr ? "" : name;
     }
-    const char* getFilenameStr() const { return name == nullptr ? "" : name->c_str(); }
-    TString* name; // descriptive name for this string, when a textual name is available, otherwise nullptr
+    int nameIndex; // of the descriptive name for this string, when a textual name is available, otherwise 0
     int string;
     int line;
     int column;
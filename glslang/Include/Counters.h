@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef _COUNTERS_INCLUDED_
+#define _COUNTERS_INCLUDED_
+
+#include "../Public/ShaderLang.h"
+
+//
+// Counting of the hot-path events of TCompileCounters.  Each thread adds its
+// events to the counters of the compile it is running, set with a TCounterScope.
+// Without ENABLE_COUNTERS, GLSLANG_COUNT() compiles to nothing and TCounterScope
+// is empty, so no thread-local state is touched at all.
+//
+
+namespace glslang {
+
+#ifdef ENABLE_COUNTERS
+
+// The counters of the compile running on this thread, or nullptr
+TCompileCounters* GetThreadCounters();
+void SetThreadCounters(TCompileCounters*);
+
+// Points this thread's counting at 'counters' for the lifetime of the scope;
+// a null 'counters' keeps the current ones.
+class TCounterScope {
+public:
+    explicit TCounterScope(TCompileCounters* counters) : previous(GetThreadCounters())
+    {
+        if (counters != nullptr)
+            SetThreadCounters(counters);
+    }
+    ~TCounterScope() { SetThreadCounters(previous); }
+
+private:
+    TCounterScope(const TCounterScope&);
+    TCounterScope& operator=(const TCounterScope&);
+
+    TCompileCounters* previous;
+};
+
+inline void AddToThreadCounter(TCounter counter, unsigned long long n)
+{
+    if (TCompileCounters* counters = GetThreadCounters())
+        counters->count[counter] += n;
+}
+#define GLSLANG_COUNT(counter, n) glslang::AddToThreadCounter(glslang::counter, n)
+
+#else
+
+class TCounterScope {
+public:
+    explicit TCounterScope(TCompileCounters*) { }
+
+private:
+    TCounterScope(const TCounterScope&);
+    TCounterScope& operator=(const TCounterScope&);
+};
+
+#define GLSLANG_COUNT(counter, n) ((void)0)
+
+#endif
+
+} // end namespace glslang
+
+#endif // _COUNTERS_INCLUDED_
@@ -1547,6 +1547,11 @@ public:
     bool isAttachmentEXT() const { return basicType == EbtSampler && sampler.isAttachmentEXT(); }
 };
 
+// Count the copies of TType for TCompileCounters.  They are out of line, and do nothing
+// without ENABLE_COUNTERS, so this header does not depend on the option.
+void CountTypeCopy();
+void CountTypeDeepCopy();
+
 //
 // Base class for things that have a type.
 //
@@ -1737,6 +1742,7 @@ public:
     // the instances are sharing the same pool.
     void shallowCopy(const TType& copyOf)
     {
+        CountTypeCopy();
         basicType = copyOf.basicType;
         sampler = copyOf.sampler;
         qualifier = copyOf.qualifier;
@@ -1763,6 +1769,7 @@ public:
     // Make complete copy of the whole type graph rooted at 'copyOf'.
     void deepCopy(const TType& copyOf)
     {
+        CountTypeDeepCopy();
         TMap<TTypeList*,TTypeList*> copied;  // to enable copying a type graph as a graph, not a tree
         deepCopy(copyOf, copied);
     }
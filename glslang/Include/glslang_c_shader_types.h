@@ -190,6 +190,7 @@ typedef enum {
     GLSLANG_REFLECTION_ALL_IO_VARIABLES_BIT = (1 << 6),
     GLSLANG_REFLECTION_SHARED_STD140_SSBO_BIT = (1 << 7),
     GLSLANG_REFLECTION_SHARED_STD140_UBO_BIT = (1 << 8),
+    GLSLANG_REFLECTION_PARALLEL_STAGES_BIT = (1 << 9),
     LAST_ELEMENT_MARKER(GLSLANG_REFLECTION_COUNT),
 } glslang_reflection_options_t;
 
@@ -42,6 +42,7 @@
 #include "gl_types.h"
 
 #include <list>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace glslang {
@@ -61,7 +62,7 @@ public:
     TLiveTraverser(const TIntermediate& i, bool traverseAll = false,
                    bool preVisit = true, bool inVisit = false, bool postVisit = false) :
         TIntermTraverser(preVisit, inVisit, postVisit),
-        intermediate(i), traverseAll(traverseAll)
+        intermediate(i), globalsIndexed(false), traverseAll(traverseAll)
     { }
 
     //
@@ -70,33 +71,18 @@ public:
     //
     void pushFunction(const TString& name)
     {
-        TIntermSequence& globals = intermediate.getTreeRoot()->getAsAggregate()->getSequence();
-        for (unsigned int f = 0; f < globals.size(); ++f) {
-            TIntermAggregate* candidate = globals[f]->getAsAggregate();
-            if (candidate && candidate->getOp() == EOpFunction && candidate->getName() == name) {
-                destinations.push_back(candidate);
-                break;
-            }
-        }
+        buildGlobalIndex();
+        auto function = functionIndex.find(name);
+        if (function != functionIndex.end())
+            destinations.push_back(function->second);
     }
 
     void pushGlobalReference(const TString& name)
     {
-        TIntermSequence& globals = intermediate.getTreeRoot()->getAsAggregate()->getSequence();
-        for (unsigned int f = 0; f < globals.size(); ++f) {
-            TIntermAggregate* candidate = globals[f]->getAsAggregate();
-            if (candidate && candidate->getOp() == EOpSequence &&
-                candidate->getSequence().size() == 1 &&
-                candidate->getSequence()[0]->getAsBinaryNode()) {
-                TIntermBinary* binary = candidate->getSequence()[0]->getAsBinaryNode();
-                TIntermSymbol* symbol = binary->getLeft()->getAsSymbolNode();
-                if (symbol && symbol->getQualifier().storage == EvqGlobal &&
-                    symbol->getName() == name) {
-                    destinations.push_back(candidate);
-                    break;
-                }
-            }
-        }
+        buildGlobalIndex();
+        auto global = globalIndex.find(name);
+        if (global != globalIndex.end())
+            destinations.push_back(global->second);
     }
 
     typedef std::list<TIntermAggregate*> TDestinationStack;
@@ -152,7 +138,37 @@ protected:
         }
     }
 
+    // Index the functions and initialized globals at the root of the tree by name, once,
+    // so finding the subroot for a call or reference does not rescan the global sequence.
+    void buildGlobalIndex()
+    {
+        if (globalsIndexed)
+            return;
+        globalsIndexed = true;
+
+        TIntermSequence& globals = intermediate.getTreeRoot()->getAsAggregate()->getSequence();
+        for (unsigned int f = 0; f < globals.size(); ++f) {
+            TIntermAggregate* candidate = globals[f]->getAsAggregate();
+            if (candidate == nullptr)
+                continue;
+            if (candidate->getOp() == EOpFunction)
+                functionIndex.emplace(candidate->getName(), candidate);
+            else if (candidate->getOp() == EOpSequence &&
+                     candidate->getSequence().size() == 1 &&
+                     candidate->getSequence()[0]->getAsBinaryNode()) {
+                TIntermBinary* binary = candidate->getSequence()[0]->getAsBinaryNode();
+                TIntermSymbol* symbol = binary->getLeft()->getAsSymbolNode();
+                if (symbol && symbol->getQualifier().storage == EvqGlobal)
+                    globalIndex.emplace(symbol->getName(), candidate);
+            }
+        }
+    }
+
     const TIntermediate& intermediate;
+    typedef std::unordered_map<TString, TIntermAggregate*> TGlobalIndex;
+    TGlobalIndex functionIndex;
+    TGlobalIndex globalIndex;
+    bool globalsIndexed;
     typedef std::unordered_set<TString> TLiveFunctions;
     TLiveFunctions liveFunctions;
     typedef std::unordered_set<TString> TLiveGlobals;
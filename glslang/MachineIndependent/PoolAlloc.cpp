@@ -34,6 +34,7 @@
 
 #include "../Include/Common.h"
 #include "../Include/PoolAlloc.h"
+#include "../Include/Counters.h"
 
 namespace glslang {
 
@@ -228,6 +229,7 @@ void* TPoolAllocator::allocate(size_t numBytes)
     //
     ++numCalls;
     totalBytes += numBytes;
+    GLSLANG_COUNT(ECounterPoolBytes, numBytes);
 
     //
     // Do the allocation, most likely case first, for efficiency.
@@ -41,9 +41,12 @@
 // GLSL scanning, leveraging the scanning done by the preprocessor.
 //
 
+#include <atomic>
 #include <cstring>
+#include <mutex>
+#include <string>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include "../Include/Types.h"
 #include "SymbolTable.h"
@@ -62,6 +65,111 @@ int yylex(YYSTYPE*, glslang::TParseContext&);
 
 namespace glslang {
 
+namespace {
+
+// Source names are kept in segments of doubling size that never move, so GetSourceName() can
+// read them without the lock while another thread adds more, and there is always room for
+// another name.  The first segment has 1 << FirstSourceNameSegmentBits names.
+const int FirstSourceNameSegmentBits = 6;
+const int SourceNameSegmentCount = 32 - FirstSourceNameSegmentBits;
+
+std::mutex sourceNameLock;
+std::unordered_map<std::string, int> sourceNameIndices;  // owns the names
+std::vector<int> sourceNameHolds;                        // by index, how many TSourceNames hold the name
+std::vector<int> freeSourceNameIndices;                  // of released names, to reuse
+std::atomic<const char**> sourceNameSegments[SourceNameSegmentCount];
+
+// Finds the slot of 'nameIndex', allocating its segment if 'allocate' is set; nullptr if
+// its segment is not allocated.
+const char** GetSourceNameSlot(int nameIndex, bool allocate)
+{
+    const unsigned int position = (unsigned int)nameIndex - 1 + (1u << FirstSourceNameSegmentBits);
+    int segment = 0;
+    while ((position >> (FirstSourceNameSegmentBits + segment)) > 1)
+        ++segment;
+    const unsigned int segmentSize = 1u << (FirstSourceNameSegmentBits + segment);
+
+    const char** names = sourceNameSegments[segment].load(std::memory_order_acquire);
+    if (names == nullptr) {
+        if (! allocate)
+            return nullptr;
+        names = new const char*[segmentSize]();
+        sourceNameSegments[segment].store(names, std::memory_order_release);
+    }
+
+    return names + (position - segmentSize);
+}
+
+} // end anonymous namespace
+
+TSourceNames::~TSourceNames()
+{
+    if (indices.empty())
+        return;
+
+    const std::lock_guard<std::mutex> lock(sourceNameLock);
+
+    for (const auto& name : indices) {
+        if (--sourceNameHolds[name.second] == 0) {
+            *GetSourceNameSlot(name.second, false) = nullptr;
+            sourceNameIndices.erase(name.first);
+            freeSourceNameIndices.push_back(name.second);
+        }
+    }
+}
+
+// Only the first lookup of a name in a compile takes the lock.
+int TSourceNames::getIndex(const char* name)
+{
+    if (name == nullptr)
+        return 0;
+
+    const auto found = indices.find(name);
+    if (found != indices.end())
+        return found->second;
+
+    const std::lock_guard<std::mutex> lock(sourceNameLock);
+
+    auto shared = sourceNameIndices.find(name);
+    if (shared == sourceNameIndices.end()) {
+        int nameIndex;
+        if (freeSourceNameIndices.empty()) {
+            if (sourceNameHolds.empty())
+                sourceNameHolds.push_back(0);  // index 0 is no name
+            nameIndex = (int)sourceNameHolds.size();
+            sourceNameHolds.push_back(0);
+        } else {
+            nameIndex = freeSourceNameIndices.back();
+            freeSourceNameIndices.pop_back();
+        }
+        shared = sourceNameIndices.emplace(name, nameIndex).first;
+        *GetSourceNameSlot(nameIndex, true) = shared->first.c_str();
+    }
+    ++sourceNameHolds[shared->second];
+    indices.emplace(name, shared->second);
+
+    return shared->second;
+}
+
+const char* GetSourceName(int nameIndex)
+{
+    const char** slot = GetSourceNameSlot(nameIndex, false);
+    return slot == nullptr ? nullptr : *slot;
+}
+
+// Frees the table once no compile holds a name.
+void ReleaseSourceNames()
+{
+    const std::lock_guard<std::mutex> lock(sourceNameLock);
+
+    if (! sourceNameIndices.empty())
+        return;
+    for (int segment = 0; segment < SourceNameSegmentCount; ++segment)
+        delete [] sourceNameSegments[segment].exchange(nullptr);
+    sourceNameHolds.clear();
+    freeSourceNameIndices.clear();
+}
+
 // read past any white space
 void TInputScanner::consumeWhiteSpace(bool& foundNonSpaceTab)
 {
@@ -322,9 +430,11 @@ struct str_hash
 };
 
 // A single global usable by all threads, by all versions, by all languages.
-// After a single process-level initialization, this is read only and thread safe
+// After a single process-level initialization, this is read only and thread safe.
+// Reserved words live in the same map, so an identifier is classified by a
+// single lookup.
 std::unordered_map<const char*, int, str_hash, str_eq>* KeywordMap = nullptr;
-std::unordered_set<const char*, str_hash, str_eq>* ReservedSet = nullptr;
+const int ReservedKeyword = -1;
 
 }
 
@@ -770,53 +880,49 @@ void TScanContext::fillInKeywordMap()
     (*KeywordMap)["hitObjectNV"] =             HITOBJECTNV;
     (*KeywordMap)["hitObjectAttributeNV"] =    HITOBJECTATTRNV;
 
-    ReservedSet = new std::unordered_set<const char*, str_hash, str_eq>;
-
-    ReservedSet->insert("common");
-    ReservedSet->insert("partition");
-    ReservedSet->insert("active");
-    ReservedSet->insert("asm");
-    ReservedSet->insert("class");
-    ReservedSet->insert("union");
-    ReservedSet->insert("enum");
-    ReservedSet->insert("typedef");
-    ReservedSet->insert("template");
-    ReservedSet->insert("this");
-    ReservedSet->insert("goto");
-    ReservedSet->insert("inline");
-    ReservedSet->insert("noinline");
-    ReservedSet->insert("public");
-    ReservedSet->insert("static");
-    ReservedSet->insert("extern");
-    ReservedSet->insert("external");
-    ReservedSet->insert("interface");
-    ReservedSet->insert("long");
-    ReservedSet->insert("short");
-    ReservedSet->insert("half");
-    ReservedSet->insert("fixed");
-    ReservedSet->insert("unsigned");
-    ReservedSet->insert("input");
-    ReservedSet->insert("output");
-    ReservedSet->insert("hvec2");
-    ReservedSet->insert("hvec3");
-    ReservedSet->insert("hvec4");
-    ReservedSet->insert("fvec2");
-    ReservedSet->insert("fvec3");
-    ReservedSet->insert("fvec4");
-    ReservedSet->insert("sampler3DRect");
-    ReservedSet->insert("filter");
-    ReservedSet->insert("sizeof");
-    ReservedSet->insert("cast");
-    ReservedSet->insert("namespace");
-    ReservedSet->insert("using");
+    (*KeywordMap)["common"] =                  ReservedKeyword;
+    (*KeywordMap)["partition"] =               ReservedKeyword;
+    (*KeywordMap)["active"] =                  ReservedKeyword;
+    (*KeywordMap)["asm"] =                     ReservedKeyword;
+    (*KeywordMap)["class"] =                   ReservedKeyword;
+    (*KeywordMap)["union"] =                   ReservedKeyword;
+    (*KeywordMap)["enum"] =                    ReservedKeyword;
+    (*KeywordMap)["typedef"] =                 ReservedKeyword;
+    (*KeywordMap)["template"] =                ReservedKeyword;
+    (*KeywordMap)["this"] =                    ReservedKeyword;
+    (*KeywordMap)["goto"] =                    ReservedKeyword;
+    (*KeywordMap)["inline"] =                  ReservedKeyword;
+    (*KeywordMap)["noinline"] =                ReservedKeyword;
+    (*KeywordMap)["public"] =                  ReservedKeyword;
+    (*KeywordMap)["static"] =                  ReservedKeyword;
+    (*KeywordMap)["extern"] =                  ReservedKeyword;
+    (*KeywordMap)["external"] =                ReservedKeyword;
+    (*KeywordMap)["interface"] =               ReservedKeyword;
+    (*KeywordMap)["long"] =                    ReservedKeyword;
+    (*KeywordMap)["short"] =                   ReservedKeyword;
+    (*KeywordMap)["half"] =                    ReservedKeyword;
+    (*KeywordMap)["fixed"] =                   ReservedKeyword;
+    (*KeywordMap)["unsigned"] =                ReservedKeyword;
+    (*KeywordMap)["input"] =                   ReservedKeyword;
+    (*KeywordMap)["output"] =                  ReservedKeyword;
+    (*KeywordMap)["hvec2"] =                   ReservedKeyword;
+    (*KeywordMap)["hvec3"] =                   ReservedKeyword;
+    (*KeywordMap)["hvec4"] =                   ReservedKeyword;
+    (*KeywordMap)["fvec2"] =                   ReservedKeyword;
+    (*KeywordMap)["fvec3"] =                   ReservedKeyword;
+    (*KeywordMap)["fvec4"] =                   ReservedKeyword;
+    (*KeywordMap)["sampler3DRect"] =           ReservedKeyword;
+    (*KeywordMap)["filter"] =                  ReservedKeyword;
+    (*KeywordMap)["sizeof"] =                  ReservedKeyword;
+    (*KeywordMap)["cast"] =                    ReservedKeyword;
+    (*KeywordMap)["namespace"] =               ReservedKeyword;
+    (*KeywordMap)["using"] =                   ReservedKeyword;
 }
 
 void TScanContext::deleteKeywordMap()
 {
     delete KeywordMap;
     KeywordMap = nullptr;
-    delete ReservedSet;
-    ReservedSet = nullptr;
 }
 
 // Called by yylex to get the next token.
@@ -924,14 +1030,13 @@ int TScanContext::tokenize(TPpContext* pp, TParserToken& token)
 
 int TScanContext::tokenizeIdentifier()
 {
-    if (ReservedSet->find(tokenText) != ReservedSet->end())
-        return reservedWord();
-
     auto it = KeywordMap->find(tokenText);
     if (it == KeywordMap->end()) {
         // Should have an identifier of some sort
         return identifierOrType();
     }
+    if (it->second == ReservedKeyword)
+        return reservedWord();
     keyword = it->second;
 
     switch (keyword) {
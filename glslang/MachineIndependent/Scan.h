@@ -51,7 +51,7 @@ const int EndOfInput = -1;
 //
 class TInputScanner {
 public:
-    TInputScanner(int n, const char* const s[], size_t L[], const char* const* names = nullptr,
+    TInputScanner(int n, const char* const s[], size_t L[], const int* nameIndices = nullptr,
                   int b = 0, int f = 0, bool single = false) :
         numSources(n),
          // up to this point, common usage is "char*", but now we need positive 8-bit characters
@@ -63,13 +63,13 @@ public:
         for (int i = 0; i < numSources; ++i) {
             loc[i].init(i - stringBias);
         }
-        if (names != nullptr) {
+        if (nameIndices != nullptr) {
             for (int i = 0; i < numSources; ++i)
-                loc[i].name = names[i] != nullptr ? NewPoolTString(names[i]) : nullptr;
+                loc[i].nameIndex = nameIndices[i];
         }
         loc[currentSource].line = 1;
         logicalSourceLoc.init(1);
-        logicalSourceLoc.name = loc[0].name;
+        logicalSourceLoc.nameIndex = loc[0].nameIndex;
     }
 
     virtual ~TInputScanner()
@@ -167,29 +167,27 @@ public:
         loc[getLastValidSourceIndex()].line = newLine;
     }
 
-    // for #line override in filename based parsing
-    void setFile(const char* filename)
+    // for #line override in filename based parsing; 'nameIndex' is from the compile's TSourceNames
+    void setFile(int nameIndex)
     {
-        TString* fn_tstr = NewPoolTString(filename);
-        logicalSourceLoc.name = fn_tstr;
-        loc[getLastValidSourceIndex()].name = fn_tstr;
+        logicalSourceLoc.nameIndex = nameIndex;
+        loc[getLastValidSourceIndex()].nameIndex = nameIndex;
     }
 
-    void setFile(const char* filename, int i)
+    void setFile(int nameIndex, int i)
     {
-        TString* fn_tstr = NewPoolTString(filename);
         if (i == getLastValidSourceIndex()) {
-            logicalSourceLoc.name = fn_tstr;
+            logicalSourceLoc.nameIndex = nameIndex;
         }
-        loc[i].name = fn_tstr;
+        loc[i].nameIndex = nameIndex;
     }
 
     void setString(int newString)
     {
         logicalSourceLoc.string = newString;
         loc[getLastValidSourceIndex()].string = newString;
-        logicalSourceLoc.name = nullptr;
-        loc[getLastValidSourceIndex()].name = nullptr;
+        logicalSourceLoc.nameIndex = 0;
+        loc[getLastValidSourceIndex()].nameIndex = 0;
     }
 
     // for #include content indentation
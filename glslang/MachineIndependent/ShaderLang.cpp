@@ -41,6 +41,7 @@
 // This is the platform independent interface between an OGL driver
 // and the shading language compiler/linker.
 //
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -54,10 +55,10 @@
 #ifdef ENABLE_HLSL
 #include "../HLSL/hlslParseHelper.h"
 #include "../HLSL/hlslParseables.h"
-#include "../HLSL/hlslScanContext.h"
 #endif
 
 #include "../Include/ShHandle.h"
+#include "../Include/Counters.h"
 
 #include "preprocessor/PpContext.h"
 
@@ -81,8 +82,8 @@ namespace { // anonymous namespace for file-local functions and symbols
 // Shared global; access should be protected by a global mutex/critical section.
 int NumberOfClients = 0;
 
-// global initialization lock
-std::mutex init_lock;
+// global initialization lock; recursive, as parsing deferred built-ins can need more of them
+std::recursive_mutex init_lock;
 
 using namespace glslang;
 
@@ -236,13 +237,45 @@ enum EPrecisionClass {
 TSymbolTable* CommonSymbolTable[VersionCount][SpvVersionCount][ProfileCount][SourceCount][EPcCount] = {};
 TSymbolTable* SharedSymbolTables[VersionCount][SpvVersionCount][ProfileCount][SourceCount][EShLangCount] = {};
 
+// The context-specific built-ins (see AddContextSpecificSymbols()) of the most common
+// contexts, each on top of the shared tables of its version, profile, and stage.  Most
+// compiles use the same few resources, so they can copy one of these instead of parsing
+// their own; a context beyond the first MaxContextSymbolTables is parsed per compile.
+struct TContextSymbolTable {
+    bool matches(const TBuiltInResource& otherResources, int otherVersion, EProfile otherProfile,
+                 const SpvVersion& otherSpvVersion, EShLanguage otherLanguage, EShSource otherSource) const
+    {
+        return version == otherVersion && profile == otherProfile && language == otherLanguage &&
+               source == otherSource && spvVersion.spv == otherSpvVersion.spv &&
+               spvVersion.vulkanGlsl == otherSpvVersion.vulkanGlsl && spvVersion.vulkan == otherSpvVersion.vulkan &&
+               spvVersion.openGl == otherSpvVersion.openGl &&
+               spvVersion.vulkanRelaxed == otherSpvVersion.vulkanRelaxed &&
+               memcmp(&resources, &otherResources, offsetof(TBuiltInResource, limits)) == 0 &&
+               memcmp(&resources.limits, &otherResources.limits, sizeof(TLimits)) == 0;
+    }
+
+    TBuiltInResource resources;
+    int version;
+    EProfile profile;
+    SpvVersion spvVersion;
+    EShLanguage language;
+    EShSource source;
+    TSymbolTable* symbolTable;  // nullptr if the built-ins of the context did not parse
+};
+
+const size_t MaxContextSymbolTables = 32;
+std::vector<TContextSymbolTable> ContextSymbolTables;
+
 TPoolAllocator* PerProcessGPA = nullptr;
 
 //
 // Parse and add to the given symbol table the content of the given shader string.
+// With 'deferFunctions', function prototypes are only parsed once looked up; see
+// ParseBuiltInFunctionFamily().  Without 'printFailure', a failure only goes to 'infoSink'.
 //
 bool InitializeSymbolTable(const TString& builtIns, int version, EProfile profile, const SpvVersion& spvVersion, EShLanguage language,
-                           EShSource source, TInfoSink& infoSink, TSymbolTable& symbolTable)
+                           EShSource source, TInfoSink& infoSink, TSymbolTable& symbolTable, bool deferFunctions = false,
+                           bool printFailure = true)
 {
     TIntermediate intermediate(language, version, profile);
 
@@ -266,19 +299,34 @@ bool InitializeSymbolTable(const TString& builtIns, int version, EProfile profil
 
     symbolTable.push();
 
+    TString nonFunctions;
+    if (deferFunctions) {
+        TBuiltInFunctionFamilies* families = new TBuiltInFunctionFamilies;
+        families->version = version;
+        families->profile = profile;
+        families->spvVersion = spvVersion;
+        families->language = language;
+        families->source = source;
+        nonFunctions = symbolTable.deferFunctions(builtIns, families);
+    }
+    const TString& parseNow = deferFunctions ? nonFunctions : builtIns;
+
     const char* builtInShaders[2];
     size_t builtInLengths[2];
-    builtInShaders[0] = builtIns.c_str();
-    builtInLengths[0] = builtIns.size();
+    builtInShaders[0] = parseNow.c_str();
+    builtInLengths[0] = parseNow.size();
 
-    if (builtInLengths[0] == 0)
+    // with its prototypes deferred, what is left can be blank, which does not parse
+    if (parseNow.find_first_not_of(" \t\n\r") == TString::npos)
         return true;
 
     TInputScanner input(1, builtInShaders, builtInLengths);
     if (! parseContext->parseShaderStrings(ppContext, input) != 0) {
         infoSink.info.message(EPrefixInternalError, "Unable to parse built-ins");
-        printf("Unable to parse built-ins\n%s\n", infoSink.info.c_str());
-        printf("%s\n", builtInShaders[0]);
+        if (printFailure) {
+            printf("Unable to parse built-ins\n%s\n", infoSink.info.c_str());
+            printf("%s\n", builtInShaders[0]);
+        }
 
         return false;
     }
@@ -300,7 +348,7 @@ void InitializeStageSymbolTable(TBuiltInParseables& builtInParseables, int versi
 {
     (*symbolTables[language]).adoptLevels(*commonTable[CommonIndex(profile, language)]);
     InitializeSymbolTable(builtInParseables.getStageString(language), version, profile, spvVersion, language, source,
-                          infoSink, *symbolTables[language]);
+                          infoSink, *symbolTables[language], true);
     builtInParseables.identifyBuiltIns(version, profile, spvVersion, language, *symbolTables[language]);
     if (profile == EEsProfile && version >= 300)
         (*symbolTables[language]).setNoBuiltInRedeclarations();
@@ -323,10 +371,10 @@ bool InitializeSymbolTables(TInfoSink& infoSink, TSymbolTable** commonTable,  TS
 
     // do the common tables
     InitializeSymbolTable(builtInParseables->getCommonString(), version, profile, spvVersion, EShLangVertex, source,
-                          infoSink, *commonTable[EPcGeneral]);
+                          infoSink, *commonTable[EPcGeneral], true);
     if (profile == EEsProfile)
         InitializeSymbolTable(builtInParseables->getCommonString(), version, profile, spvVersion, EShLangFragment, source,
-                              infoSink, *commonTable[EPcFragment]);
+                              infoSink, *commonTable[EPcFragment], true);
 
     // do the per-stage tables
 
@@ -388,8 +436,14 @@ bool InitializeSymbolTables(TInfoSink& infoSink, TSymbolTable** commonTable,  TS
     return true;
 }
 
+//
+// Add the built-ins that depend on the resources to the given symbol table.  'parsed', if
+// given, tells whether they parsed, and then a failure only goes to 'infoSink': the caller
+// reports it.
+//
 bool AddContextSpecificSymbols(const TBuiltInResource* resources, TInfoSink& infoSink, TSymbolTable& symbolTable, int version,
-                               EProfile profile, const SpvVersion& spvVersion, EShLanguage language, EShSource source)
+                               EProfile profile, const SpvVersion& spvVersion, EShLanguage language, EShSource source,
+                               bool* parsed = nullptr)
 {
     std::unique_ptr<TBuiltInParseables> builtInParseables(CreateBuiltInParseables(infoSink, source));
 
@@ -397,7 +451,10 @@ bool AddContextSpecificSymbols(const TBuiltInResource* resources, TInfoSink& inf
         return false;
 
     builtInParseables->initialize(*resources, version, profile, spvVersion, language);
-    InitializeSymbolTable(builtInParseables->getCommonString(), version, profile, spvVersion, language, source, infoSink, symbolTable);
+    bool builtInsParsed = InitializeSymbolTable(builtInParseables->getCommonString(), version, profile, spvVersion,
+                                                language, source, infoSink, symbolTable, false, parsed == nullptr);
+    if (parsed != nullptr)
+        *parsed = builtInsParsed;
     builtInParseables->identifyBuiltIns(version, profile, spvVersion, language, symbolTable, *resources);
 
     return true;
@@ -420,7 +477,7 @@ void SetupBuiltinSymbolTable(int version, EProfile profile, const SpvVersion& sp
     TInfoSink infoSink;
 
     // Make sure only one thread tries to do this at a time
-    const std::lock_guard<std::mutex> lock(init_lock);
+    const std::lock_guard<std::recursive_mutex> lock(init_lock);
 
     // See if it's already been done for this version/profile combination
     int versionIndex = MapVersionToIndex(version);
@@ -455,6 +512,7 @@ void SetupBuiltinSymbolTable(int version, EProfile profile, const SpvVersion& sp
             CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex][precClass] = new TSymbolTable;
             CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex][precClass]->copyTable(*commonTable[precClass]);
             CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex][precClass]->readOnly();
+            CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex][precClass]->setDeferredContext();
         }
     }
     for (int stage = 0; stage < EShLangCount; ++stage) {
@@ -464,6 +522,7 @@ void SetupBuiltinSymbolTable(int version, EProfile profile, const SpvVersion& sp
                               [versionIndex][spvVersionIndex][profileIndex][sourceIndex][CommonIndex(profile, (EShLanguage)stage)]);
             SharedSymbolTables[versionIndex][spvVersionIndex][profileIndex][sourceIndex][stage]->copyTable(*stageTables[stage]);
             SharedSymbolTables[versionIndex][spvVersionIndex][profileIndex][sourceIndex][stage]->readOnly();
+            SharedSymbolTables[versionIndex][spvVersionIndex][profileIndex][sourceIndex][stage]->setDeferredContext();
         }
     }
 
@@ -477,6 +536,60 @@ void SetupBuiltinSymbolTable(int version, EProfile profile, const SpvVersion& sp
     SetThreadPoolAllocator(&previousAllocator);
 }
 
+//
+// Return a process-global table holding the shared levels of 'sharedTable' with the
+// context-specific built-ins added on top, building it the first time the context is
+// seen, the same way SetupBuiltinSymbolTable() builds the shared tables.
+//
+// Returns nullptr if there is no room for another context, or if its built-ins do not
+// parse; the caller then adds the context-specific built-ins itself, into its own log.
+// A context that does not parse is remembered as such, so it is only tried once here,
+// and without a word: each compile of it reports the failure once, from its own parse.
+//
+TSymbolTable* SetupContextSymbolTable(TSymbolTable& sharedTable, const TBuiltInResource& resources, int version,
+                                      EProfile profile, const SpvVersion& spvVersion, EShLanguage language,
+                                      EShSource source)
+{
+    const std::lock_guard<std::recursive_mutex> lock(init_lock);
+
+    for (const TContextSymbolTable& context : ContextSymbolTables) {
+        if (context.matches(resources, version, profile, spvVersion, language, source))
+            return context.symbolTable;
+    }
+    if (ContextSymbolTables.size() == MaxContextSymbolTables)
+        return nullptr;
+
+    TInfoSink infoSink;
+
+    TPoolAllocator& previousAllocator = GetThreadPoolAllocator();
+    TPoolAllocator* contextPoolAllocator = new TPoolAllocator;
+    SetThreadPoolAllocator(contextPoolAllocator);
+
+    TSymbolTable* localTable = new TSymbolTable;
+    localTable->adoptLevels(sharedTable);
+    bool parsed = false;
+    bool added = AddContextSpecificSymbols(&resources, infoSink, *localTable, version, profile, spvVersion,
+                                           language, source, &parsed) &&
+                 parsed;
+
+    SetThreadPoolAllocator(PerProcessGPA);
+
+    TSymbolTable* contextTable = nullptr;
+    if (added) {
+        contextTable = new TSymbolTable;
+        contextTable->adoptLevels(sharedTable);
+        contextTable->copyTable(*localTable);
+        contextTable->readOnly();
+    }
+    ContextSymbolTables.push_back({ resources, version, profile, spvVersion, language, source, contextTable });
+
+    delete localTable;
+    delete contextPoolAllocator;
+    SetThreadPoolAllocator(&previousAllocator);
+
+    return contextTable;
+}
+
 // Function to Print all builtins
 void DumpBuiltinSymbolTable(TInfoSink& infoSink, const TSymbolTable& symbolTable)
 {
@@ -907,7 +1020,10 @@ bool ProcessDeferred(
         for (int s = 0; s < numStrings; ++s) {
             // The string may not be null-terminated, so make sure we provide
             // the length along with the string.
-            intermediate.addSourceText(strings[numPre + s], lengths[numPre + s]);
+            if (intermediate.getSourceTextRetained())
+                intermediate.referenceSourceText(strings[numPre + s], lengths[numPre + s]);
+            else
+                intermediate.addSourceText(strings[numPre + s], lengths[numPre + s]);
         }
     }
     SetupBuiltinSymbolTable(version, profile, spvVersion, source);
@@ -918,19 +1034,32 @@ bool ProcessDeferred(
                                                   [MapSourceToIndex(source)]
                                                   [stage];
 
+    // Unless this compile continues the unique ids of another, its context-specific
+    // built-ins can be copied from the ones already parsed for its context.
+    TSymbolTable* contextTable = nullptr;
+    if (cachedTable && intermediate.getUniqueId() == 0)
+        contextTable = SetupContextSymbolTable(*cachedTable, *resources, version, profile, spvVersion, stage, source);
+
     // Dynamically allocate the symbol table so we can control when it is deallocated WRT the pool.
     std::unique_ptr<TSymbolTable> symbolTable(new TSymbolTable);
     if (cachedTable)
         symbolTable->adoptLevels(*cachedTable);
+    symbolTable->setInfoSink(&compiler->infoSink);
 
-    if (intermediate.getUniqueId() != 0)
-        symbolTable->overwriteUniqueId(intermediate.getUniqueId());
-
-    // Add built-in symbols that are potentially context dependent;
-    // they get popped again further down.
-    if (! AddContextSpecificSymbols(resources, compiler->infoSink, *symbolTable, version, profile, spvVersion,
-                                    stage, source)) {
-        return false;
+    if (contextTable) {
+        // A writable copy, as when parsed: this compile may edit its context-specific
+        // built-ins in place, like sizing gl_in.
+        symbolTable->copyTable(*contextTable);
+    } else {
+        if (intermediate.getUniqueId() != 0)
+            symbolTable->overwriteUniqueId(intermediate.getUniqueId());
+
+        // Add built-in symbols that are potentially context dependent;
+        // they get popped again further down.
+        if (! AddContextSpecificSymbols(resources, compiler->infoSink, *symbolTable, version, profile, spvVersion,
+                                        stage, source)) {
+            return false;
+        }
     }
 
     if (messages & EShMsgBuiltinSymbolTable)
@@ -979,7 +1108,10 @@ bool ProcessDeferred(
         lengths[postIndex] = strlen(strings[numStrings + numPre]);
         names[postIndex] = nullptr;
     }
-    TInputScanner fullInput(numStrings + numPre + numPost, strings.get(), lengths.get(), names.get(), numPre, numPost);
+    std::unique_ptr<int[]> nameIndices(new int[numTotal]);
+    for (int s = 0; s < numTotal; ++s)
+        nameIndices[s] = intermediate.getSourceNames().getIndex(names[s]);
+    TInputScanner fullInput(numTotal, strings.get(), lengths.get(), nameIndices.get(), numPre, numPost);
 
     // Push a new symbol allocation scope that will get used for the shader's globals.
     symbolTable->push();
@@ -1199,6 +1331,114 @@ struct DoPreprocessing {
     std::string* outputString;
 };
 
+// DoFingerprint is a valid ProcessingContext template argument, which,
+// like DoPreprocessing, only runs the preprocessor, but hashes the token
+// stream instead of building its text.  See TShader::fingerprint().
+struct DoFingerprint {
+    explicit DoFingerprint(unsigned long long* fingerprint) : fingerprint(fingerprint), hash(14695981039346656037ull) {}
+    bool operator()(TParseContextBase& parseContext, TPpContext& ppContext,
+                    TInputScanner& input, bool versionWillBeError,
+                    TSymbolTable&, TIntermediate&,
+                    EShOptimizationLevel, EShMessages)
+    {
+        glslang::TPpToken ppToken;
+
+        parseContext.setScanner(&input);
+        ppContext.setInput(input, versionWillBeError);
+
+        // Directives that reach the parse context rather than the token stream.
+        // #version is covered by the version and profile it resolves to, below,
+        // and #line only moves diagnostics, so both are left out.
+        parseContext.setExtensionCallback([this](int, const char* extension, const char* behavior) {
+            add('e');
+            add(extension);
+            add(behavior);
+        });
+        parseContext.setPragmaCallback([this](int, const glslang::TVector<glslang::TString>& ops) {
+            add('p');
+            add((int)ops.size());
+            for (const auto& op : ops)
+                add(op.c_str());
+        });
+
+        do {
+            int token = ppContext.tokenize(ppToken);
+            if (token == EndOfInput)
+                break;
+
+            // Literals by value, so e.g. 0x10 and 16 agree; the rest by spelling
+            add(token);
+            switch (token) {
+            case PpAtomConstInt:
+            case PpAtomConstUint:
+            case PpAtomConstInt16:
+            case PpAtomConstUint16:
+                add(ppToken.ival);
+                break;
+            case PpAtomConstInt64:
+            case PpAtomConstUint64:
+                add((unsigned long long)ppToken.i64val);
+                break;
+            case PpAtomConstFloat:
+            case PpAtomConstDouble:
+            case PpAtomConstFloat16:
+                add(ppToken.dval);
+                break;
+            case PpAtomIdentifier:
+            case PpAtomConstString:
+                add(ppToken.name);
+                break;
+            default:
+                // operators and punctuation are fully described by the token
+                break;
+            }
+        } while (true);
+
+        // The version and profile in effect, whether from #version or the defaults
+        add('V');
+        add(parseContext.version);
+        add((int)parseContext.profile);
+        add((int)parseContext.getLanguage());
+        *fingerprint = hash;
+
+        bool success = true;
+        if (parseContext.getNumErrors() > 0) {
+            success = false;
+            parseContext.infoSink.info.prefix(EPrefixError);
+            parseContext.infoSink.info << parseContext.getNumErrors() << " compilation errors.  No code generated.\n\n";
+        }
+        return success;
+    }
+
+protected:
+    // 64-bit FNV-1a over the bytes of each item
+    void add(const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    void add(int value) { add((unsigned long long)(unsigned int)value); }
+    void add(unsigned long long value)
+    {
+        unsigned char bytes[8];
+        for (int i = 0; i < 8; ++i)
+            bytes[i] = (unsigned char)(value >> (8 * i));
+        add(bytes, sizeof(bytes));
+    }
+    void add(double value)
+    {
+        unsigned long long bits;
+        memcpy(&bits, &value, sizeof(bits));
+        add(bits);
+    }
+    // including the terminator, so adjacent strings cannot run together
+    void add(const char* str) { add(str, strlen(str) + 1); }
+
+    unsigned long long* fingerprint;
+    unsigned long long hash;
+};
+
 // DoFullParse is a valid ProcessingConext template argument for fully
 // parsing the shader.  It populates the "intermediate" with the AST.
 struct DoFullParse{
@@ -1264,6 +1504,36 @@ bool PreprocessDeferred(
                            false, includer, "", environment);
 }
 
+// Take a single compilation unit, and run the preprocessor on it, hashing
+// its tokens into "fingerprint".
+// Return: same as PreprocessDeferred().
+bool FingerprintDeferred(
+    TCompiler* compiler,
+    const char* const shaderStrings[],
+    const int numStrings,
+    const int* inputLengths,
+    const char* const stringNames[],
+    const char* preamble,
+    const TBuiltInResource* resources,
+    int defaultVersion,
+    EProfile defaultProfile,
+    bool forceDefaultVersionAndProfile,
+    int overrideVersion,
+    bool forwardCompatible,
+    EShMessages messages,
+    TShader::Includer& includer,
+    TIntermediate& intermediate,
+    unsigned long long* fingerprint,
+    TEnvironment* environment = nullptr)
+{
+    DoFingerprint parser(fingerprint);
+    return ProcessDeferred(compiler, shaderStrings, numStrings, inputLengths, stringNames,
+                           preamble, EShOptNone, resources, defaultVersion,
+                           defaultProfile, forceDefaultVersionAndProfile, overrideVersion,
+                           forwardCompatible, messages, intermediate, parser,
+                           false, includer, "", environment);
+}
+
 //
 // do a partial compile on the given strings for a single compilation unit
 // for a potential deferred link into a single stage (and deferred full compile of that
@@ -1306,21 +1576,76 @@ bool CompileDeferred(
 
 } // end anonymous namespace for local functions
 
+namespace glslang {
+
+//
+// Parse the prototypes of one deferred built-in function name, the same way as
+// SetupBuiltinSymbolTable() parses the rest: in a pool of their own, then copied to the
+// process-global pool, where they are published to every compile using the shared table.
+//
+// Prototypes that do not parse are not published.  The family is marked failed instead,
+// so it is only tried once, and each compile looking it up gets the error in its own log.
+//
+void ParseBuiltInFunctionFamily(const TBuiltInFunctionFamilies& families, const TString& name,
+                                TBuiltInFunctionFamily& family, TInfoSink* compileInfoSink)
+{
+    const std::lock_guard<std::recursive_mutex> lock(init_lock);
+
+    // another thread got here first, or this one is already at it further up
+    if (family.functions.load(std::memory_order_acquire) != nullptr || family.parsing)
+        return;
+
+    if (! family.failed) {
+        family.parsing = true;
+
+        TInfoSink infoSink;
+        TPoolAllocator& previousAllocator = GetThreadPoolAllocator();
+        TPoolAllocator* builtInPoolAllocator = new TPoolAllocator;
+        SetThreadPoolAllocator(builtInPoolAllocator);
+
+        TSymbolTable* symbolTable = new TSymbolTable;
+        symbolTable->adoptBuiltInLevels(*families.context);
+        const bool parsed = InitializeSymbolTable(family.prototypes, families.version, families.profile,
+                                                  families.spvVersion, families.language, families.source, infoSink,
+                                                  *symbolTable);
+
+        SetThreadPoolAllocator(PerProcessGPA);
+        if (parsed)
+            family.publish(symbolTable->cloneTopLevel());
+        else
+            family.failed = true;
+
+        delete symbolTable;
+        delete builtInPoolAllocator;
+        SetThreadPoolAllocator(&previousAllocator);
+        family.parsing = false;
+
+        if (parsed)
+            return;
+    }
+
+    // once per compile, however often it looks the name up
+    if (compileInfoSink != nullptr) {
+        const std::string message = std::string("Unable to parse built-in function ") + name.c_str();
+        if (strstr(compileInfoSink->info.c_str(), message.c_str()) == nullptr)
+            compileInfoSink->info.message(EPrefixInternalError, message.c_str());
+    }
+}
+
+} // end namespace glslang
+
 //
 // ShInitialize() should be called exactly once per process, not per thread.
 //
 int ShInitialize()
 {
-    const std::lock_guard<std::mutex> lock(init_lock);
+    const std::lock_guard<std::recursive_mutex> lock(init_lock);
     ++NumberOfClients;
 
     if (PerProcessGPA == nullptr)
         PerProcessGPA = new TPoolAllocator();
 
     glslang::TScanContext::fillInKeywordMap();
-#ifdef ENABLE_HLSL
-    glslang::HlslScanContext::fillInKeywordMap();
-#endif
 
     return 1;
 }
@@ -1371,12 +1696,17 @@ void ShDestruct(ShHandle handle)
 //
 int ShFinalize()
 {
-    const std::lock_guard<std::mutex> lock(init_lock);
+    const std::lock_guard<std::recursive_mutex> lock(init_lock);
     --NumberOfClients;
     assert(NumberOfClients >= 0);
     if (NumberOfClients > 0)
         return 1;
 
+    // these adopt the shared tables, so go first
+    for (TContextSymbolTable& context : ContextSymbolTables)
+        delete context.symbolTable;
+    ContextSymbolTables.clear();
+
     for (int version = 0; version < VersionCount; ++version) {
         for (int spvVersion = 0; spvVersion < SpvVersionCount; ++spvVersion) {
             for (int p = 0; p < ProfileCount; ++p) {
@@ -1409,9 +1739,7 @@ int ShFinalize()
     }
 
     glslang::TScanContext::deleteKeywordMap();
-#ifdef ENABLE_HLSL
-    glslang::HlslScanContext::deleteKeywordMap();
-#endif
+    glslang::ReleaseSourceNames();
 
     return 1;
 }
@@ -1711,6 +2039,58 @@ void FinalizeProcess()
     ShFinalize();
 }
 
+#ifdef ENABLE_COUNTERS
+namespace {
+thread_local TCompileCounters* threadCounters = nullptr;
+} // anonymous namespace
+
+TCompileCounters* GetThreadCounters()
+{
+    return threadCounters;
+}
+
+void SetThreadCounters(TCompileCounters* counters)
+{
+    threadCounters = counters;
+}
+#endif
+
+void CountTypeCopy()
+{
+    GLSLANG_COUNT(ECounterTypeCopies, 1);
+}
+
+void CountTypeDeepCopy()
+{
+    GLSLANG_COUNT(ECounterTypeDeepCopies, 1);
+}
+
+bool CountersEnabled()
+{
+#ifdef ENABLE_COUNTERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* TCompileCounters::getName(TCounter counter)
+{
+    switch (counter) {
+    case ECounterSymbolFinds:         return "symbol finds";
+    case ECounterSymbolLevelsProbed:  return "symbol levels probed";
+    case ECounterFunctionCandidates:  return "function candidates";
+    case ECounterTypeCopies:          return "type copies";
+    case ECounterTypeDeepCopies:      return "type deep copies";
+    case ECounterPoolBytes:           return "pool bytes";
+    case ECounterSpvTypeProbes:       return "SPIR-V type probes";
+    case ECounterSpvConstantProbes:   return "SPIR-V constant probes";
+    case ECounterMacroExpansions:     return "macro expansions";
+    case ECounterTokensScanned:       return "tokens scanned";
+    default:                          return "unknown";
+    }
+}
+
 class TDeferredCompiler : public TCompiler {
 public:
     TDeferredCompiler(EShLanguage s, TInfoSink& i) : TCompiler(s, i) { }
@@ -1864,10 +2244,14 @@ bool TShader::parse(const TBuiltInResource* builtInResources, int defaultVersion
                     bool forwardCompatible, EShMessages messages, Includer& includer)
 {
     SetThreadPoolAllocator(pool);
+    counters.reset();
+    TCounterScope counterScope(&counters);
 
     if (! preamble)
         preamble = "";
 
+    intermediate->setSourceTextRetained(stringsRetained);
+
     return CompileDeferred(compiler, strings, numStrings, lengths, stringNames,
                            preamble, EShOptNone, builtInResources, defaultVersion,
                            defaultProfile, forceDefaultVersionAndProfile, overrideVersion,
@@ -1888,6 +2272,8 @@ bool TShader::preprocess(const TBuiltInResource* builtInResources,
                          Includer& includer)
 {
     SetThreadPoolAllocator(pool);
+    counters.reset();
+    TCounterScope counterScope(&counters);
 
     if (! preamble)
         preamble = "";
@@ -1899,6 +2285,30 @@ bool TShader::preprocess(const TBuiltInResource* builtInResources,
                               &environment);
 }
 
+// Set "fingerprint" to a hash of the preprocessed token stream; see the
+// declaration.  Returns true if all extensions, pragmas and version strings
+// were valid.
+bool TShader::fingerprint(const TBuiltInResource* builtInResources,
+                          int defaultVersion, EProfile defaultProfile,
+                          bool forceDefaultVersionAndProfile,
+                          bool forwardCompatible, EShMessages message,
+                          unsigned long long* fingerprint,
+                          Includer& includer)
+{
+    SetThreadPoolAllocator(pool);
+    counters.reset();
+    TCounterScope counterScope(&counters);
+
+    if (! preamble)
+        preamble = "";
+
+    return FingerprintDeferred(compiler, strings, numStrings, lengths, stringNames, preamble,
+                               builtInResources, defaultVersion,
+                               defaultProfile, forceDefaultVersionAndProfile, overrideVersion,
+                               forwardCompatible, message, includer, *intermediate, fingerprint,
+                               &environment);
+}
+
 const char* TShader::getInfoLog()
 {
     return infoSink->info.c_str();
@@ -1948,6 +2358,7 @@ bool TProgram::link(EShMessages messages)
     SetThreadPoolAllocator(pool);
 
     for (int s = 0; s < EShLangCount; ++s) {
+        counters[s].reset();
         if (! linkStage((EShLanguage)s, messages))
             error = true;
     }
@@ -1960,6 +2371,20 @@ bool TProgram::link(EShMessages messages)
     return ! error;
 }
 
+//
+// See the comments on freeze() in ShaderLang.h.  Nothing reachable from the intermediates is
+// written after this: GlslangToSpv() takes them const, allocates only from the calling
+// thread's pool, and keeps all of its state in its own traverser, builder and logger.
+//
+bool TProgram::freeze()
+{
+    if (! linked)
+        return false;
+    frozen = true;
+
+    return true;
+}
+
 //
 // Merge the compilation units within the given stage into a single TIntermediate.
 //
@@ -1970,6 +2395,8 @@ bool TProgram::linkStage(EShLanguage stage, EShMessages messages)
     if (stages[stage].size() == 0)
         return true;
 
+    TCounterScope counterScope(&counters[stage]);
+
     int numEsShaders = 0, numNonEsShaders = 0;
     for (auto it = stages[stage].begin(); it != stages[stage].end(); ++it) {
         if ((*it)->intermediate->getProfile() == EEsProfile) {
@@ -2109,7 +2536,7 @@ unsigned int TObjectReflection::layoutLocation() const { return type->getQualifi
 
 bool TProgram::buildReflection(int opts)
 {
-    if (! linked || reflection != nullptr)
+    if (! linked || frozen || reflection != nullptr)
         return false;
 
     int firstStage = EShLangVertex, lastStage = EShLangFragment;
@@ -2129,6 +2556,9 @@ bool TProgram::buildReflection(int opts)
 
     reflection = new TReflection((EShReflectionOptions)opts, (EShLanguage)firstStage, (EShLanguage)lastStage);
 
+    if (opts & EShReflectionParallelStages)
+        return reflection->addStages(intermediate);
+
     for (int s = 0; s < EShLangCount; ++s) {
         if (intermediate[s]) {
             if (! reflection->addStage((EShLanguage)s, *intermediate[s]))
@@ -2160,12 +2590,22 @@ int TProgram::getNumAtomicCounters() const                            { return r
 const TObjectReflection& TProgram::getAtomicCounter(int index) const  { return reflection->getAtomicCounter(index); }
 void TProgram::dumpReflection() { if (reflection != nullptr) reflection->dump(); }
 
+bool TProgram::getReflectionBinary(std::vector<unsigned int>& words) const
+{
+    if (reflection == nullptr)
+        return false;
+
+    reflection->getBinary(words);
+
+    return true;
+}
+
 //
 // I/O mapping implementation.
 //
 bool TProgram::mapIO(TIoMapResolver* pResolver, TIoMapper* pIoMapper)
 {
-    if (! linked)
+    if (! linked || frozen)
         return false;
     TIoMapper* ioMapper = nullptr;
     TIoMapper defaultIOMapper;
@@ -247,6 +247,15 @@ void TSymbolTableLevel::dump(TInfoSink& infoSink, bool complete) const
     tLevel::const_iterator it;
     for (it = level.begin(); it != level.end(); ++it)
         (*it).second->dump(infoSink, complete);
+
+    // deferred built-ins follow, parsed for the occasion
+    if (deferredFunctions != nullptr) {
+        for (const auto& family : deferredFunctions->families) {
+            const TSymbolTableLevel* functions = findFunctionFamily(family.first);
+            if (functions != nullptr)
+                functions->dump(infoSink, complete);
+        }
+    }
 }
 
 void TSymbolTable::dump(TInfoSink& infoSink, bool complete) const
@@ -279,16 +288,147 @@ TSymbolTableLevel::~TSymbolTableLevel()
             delete (*it).second;
     }
 
+    if (deferredFunctions != nullptr) {
+        for (const auto& family : deferredFunctions->families) {
+            delete family.second->functions.load();
+            delete family.second;
+        }
+        delete deferredFunctions;
+    }
 
     delete [] defaultPrecision;
 }
 
+//
+// Split a built-in string into the statements to parse now, which are returned, and the
+// function prototypes, which are kept by name to be parsed on first lookup of the name.
+// Each prototype leaves blank space behind, so the statements keep their locations.
+//
+TString TSymbolTableLevel::deferFunctions(const TString& builtIns, TBuiltInFunctionFamilies* families)
+{
+    deferredFunctions = families;
+
+    // The name of the function a statement declares, or "" if it is not a prototype:
+    // "<return type> <name>(<parameters>)", with no initializer or body.
+    const auto prototypeName = [&builtIns](size_t start, size_t end) -> TString {
+        while (end > start && isspace((unsigned char)builtIns[end - 1]))
+            --end;
+        if (end == start || builtIns[end - 1] != ')')
+            return TString();
+
+        size_t parenAt = builtIns.find_first_of("(={", start);
+        if (parenAt >= end || builtIns[parenAt] != '(')
+            return TString();
+
+        size_t nameEnd = parenAt;
+        while (nameEnd > start && isspace((unsigned char)builtIns[nameEnd - 1]))
+            --nameEnd;
+        size_t nameStart = nameEnd;
+        while (nameStart > start && (isalnum((unsigned char)builtIns[nameStart - 1]) || builtIns[nameStart - 1] == '_'))
+            --nameStart;
+        if (nameStart == nameEnd || isdigit((unsigned char)builtIns[nameStart]))
+            return TString();
+
+        // need a return type before the name
+        size_t typeEnd = nameStart;
+        while (typeEnd > start && isspace((unsigned char)builtIns[typeEnd - 1]))
+            --typeEnd;
+        if (typeEnd == start)
+            return TString();
+
+        TString name(builtIns, nameStart, nameEnd - nameStart);
+        if (name == "layout")
+            return TString();
+
+        return name;
+    };
+
+    TString now;
+    size_t start = 0;
+    int depth = 0;
+    for (size_t c = 0; c < builtIns.size(); ++c) {
+        if (builtIns[c] == '{')
+            ++depth;
+        else if (builtIns[c] == '}')
+            --depth;
+        else if (builtIns[c] == ';' && depth == 0) {
+            TString name = prototypeName(start, c);
+            if (name.empty())
+                now.append(builtIns, start, c + 1 - start);
+            else {
+                TBuiltInFunctionFamily*& family = families->families[name];
+                if (family == nullptr)
+                    family = new TBuiltInFunctionFamily;
+                family->prototypes.append(builtIns, start, c + 1 - start);
+
+                // keep the lines and columns of what follows, which end up in locations,
+                // e.g., those of built-in block members in debug info
+                size_t lineStart = builtIns.find_last_of('\n', c);
+                if (lineStart == TString::npos || lineStart < start)
+                    lineStart = start;
+                else {
+                    ++lineStart;
+                    now.append(std::count(builtIns.begin() + start, builtIns.begin() + lineStart, '\n'), '\n');
+                }
+                now.append(c + 1 - lineStart, ' ');
+            }
+            start = c + 1;
+        }
+    }
+    now.append(builtIns, start, builtIns.size() - start);
+
+    return now;
+}
+
+static void ApplyFunctionAction(TSymbolTableLevel& functions, const TBuiltInFunctionAction& action)
+{
+    const int numExtensions = (int)action.extensions.size();
+    switch (action.kind) {
+    case TBuiltInFunctionAction::ERelateToOperator:
+        functions.relateToOperator(action.name.c_str(), action.op);
+        break;
+    case TBuiltInFunctionAction::EFunctionExtensions:
+        functions.setFunctionExtensions(action.name.c_str(), numExtensions, action.extensions.data());
+        break;
+    case TBuiltInFunctionAction::ESingleFunctionExtensions:
+        functions.setSingleFunctionExtensions(action.name.c_str(), numExtensions, action.extensions.data());
+        break;
+    }
+}
+
+// Apply an action on all overloads of a deferred family, now or once they are parsed.
+void TBuiltInFunctionFamily::act(const TBuiltInFunctionAction& action)
+{
+    TSymbolTableLevel* parsed = functions.load(std::memory_order_acquire);
+    if (parsed != nullptr)
+        ApplyFunctionAction(*parsed, action);
+    else
+        actions.push_back(action);
+}
+
+// Catch the parsed overloads up with the actions recorded so far, then make them visible.
+void TBuiltInFunctionFamily::publish(TSymbolTableLevel* parsed)
+{
+    for (const TBuiltInFunctionAction& action : actions)
+        ApplyFunctionAction(*parsed, action);
+    parsed->readOnly();
+    functions.store(parsed, std::memory_order_release);
+}
+
 //
 // Change all function entries in the table with the non-mangled name
 // to be related to the provided built-in operation.
 //
 void TSymbolTableLevel::relateToOperator(const char* name, TOperator op)
 {
+    if (deferredFunctions != nullptr) {
+        auto family = deferredFunctions->families.find(TString(name));
+        if (family != deferredFunctions->families.end()) {
+            TBuiltInFunctionAction action{TBuiltInFunctionAction::ERelateToOperator, name, op, {}};
+            family->second->act(action);
+        }
+    }
+
     tLevel::const_iterator candidate = level.lower_bound(name);
     while (candidate != level.end()) {
         const TString& candidateName = (*candidate).first;
@@ -306,6 +446,15 @@ void TSymbolTableLevel::relateToOperator(const char* name, TOperator op)
 // Should only be used for a version/profile that actually needs the extension(s).
 void TSymbolTableLevel::setFunctionExtensions(const char* name, int num, const char* const extensions[])
 {
+    if (deferredFunctions != nullptr) {
+        auto family = deferredFunctions->families.find(TString(name));
+        if (family != deferredFunctions->families.end()) {
+            TBuiltInFunctionAction action{TBuiltInFunctionAction::EFunctionExtensions, name, EOpNull, {}};
+            action.extensions.assign(extensions, extensions + num);
+            family->second->act(action);
+        }
+    }
+
     tLevel::const_iterator candidate = level.lower_bound(name);
     while (candidate != level.end()) {
         const TString& candidateName = (*candidate).first;
@@ -324,6 +473,17 @@ void TSymbolTableLevel::setFunctionExtensions(const char* name, int num, const c
 // Should only be used for a version/profile that actually needs the extension(s).
 void TSymbolTableLevel::setSingleFunctionExtensions(const char* name, int num, const char* const extensions[])
 {
+    if (deferredFunctions != nullptr) {
+        const char* parenAt = strchr(name, '(');
+        auto family = parenAt == nullptr ? deferredFunctions->families.end()
+                                         : deferredFunctions->families.find(TString(name, parenAt - name));
+        if (family != deferredFunctions->families.end()) {
+            TBuiltInFunctionAction action{TBuiltInFunctionAction::ESingleFunctionExtensions, name, EOpNull, {}};
+            action.extensions.assign(extensions, extensions + num);
+            family->second->act(action);
+        }
+    }
+
     if (auto candidate = level.find(name); candidate != level.end()) {
         candidate->second->setExtensions(num, extensions);
     }
@@ -460,6 +620,28 @@ TSymbolTableLevel* TSymbolTableLevel::clone() const
         symTableLevel->insert(s.first, sym);
     }
 
+    if (deferredFunctions != nullptr) {
+        TBuiltInFunctionFamilies* families = new TBuiltInFunctionFamilies;
+        families->version = deferredFunctions->version;
+        families->profile = deferredFunctions->profile;
+        families->spvVersion = deferredFunctions->spvVersion;
+        families->language = deferredFunctions->language;
+        families->source = deferredFunctions->source;
+        for (const auto& family : deferredFunctions->families) {
+            TBuiltInFunctionFamily* copy = new TBuiltInFunctionFamily;
+            copy->prototypes = family.second->prototypes;
+            copy->actions = family.second->actions;
+            TSymbolTableLevel* functions = family.second->functions.load(std::memory_order_acquire);
+            if (functions != nullptr) {
+                functions = functions->clone();
+                functions->readOnly();
+                copy->functions.store(functions, std::memory_order_relaxed);
+            }
+            families->families[family.first] = copy;
+        }
+        symTableLevel->deferredFunctions = families;
+    }
+
     return symTableLevel;
 }
 
@@ -68,6 +68,9 @@
 #include "../Include/Common.h"
 #include "../Include/intermediate.h"
 #include "../Include/InfoSink.h"
+#include "../Include/Counters.h"
+
+#include <atomic>
 
 namespace glslang {
 
@@ -402,10 +405,59 @@ protected:
     int anonId;
 };
 
+class TSymbolTable;
+class TSymbolTableLevel;
+
+//
+// The prototypes of built-in functions are not all parsed up front.  A shared level
+// keeps the text declaring all overloads of a name, and parses it into a level of its
+// own the first time the name is looked up.  Operator relations and extension
+// requirements set on a name before then are recorded, and applied once parsed.
+//
+struct TBuiltInFunctionAction {
+    enum TKind { ERelateToOperator, EFunctionExtensions, ESingleFunctionExtensions };
+
+    TKind kind;
+    TString name;  // mangled, for ESingleFunctionExtensions
+    TOperator op;
+    TVector<const char*> extensions;
+};
+
+struct TBuiltInFunctionFamily {
+    POOL_ALLOCATOR_NEW_DELETE(GetThreadPoolAllocator())
+
+    void act(const TBuiltInFunctionAction&);
+    void publish(TSymbolTableLevel* parsed);
+
+    TString prototypes;
+    TVector<TBuiltInFunctionAction> actions;
+    std::atomic<TSymbolTableLevel*> functions { nullptr };  // once parsed
+    bool parsing = false;                                   // guarded by the built-in setup lock
+    bool failed = false;                                    // the prototypes did not parse; same lock
+};
+
+struct TBuiltInFunctionFamilies {
+    POOL_ALLOCATOR_NEW_DELETE(GetThreadPoolAllocator())
+
+    int version;
+    EProfile profile;
+    SpvVersion spvVersion;
+    EShLanguage language;
+    EShSource source;
+    TSymbolTable* context = nullptr;  // the shared table owning the level; none while it is built
+    TMap<TString, TBuiltInFunctionFamily*> families;
+};
+
+// Parses the prototypes of 'family', named 'name', against 'families.context', and publishes
+// them; defined with the rest of the built-in setup.  If they do not parse, the family is
+// marked failed, and each compile looking it up is told so in its 'infoSink', when given.
+void ParseBuiltInFunctionFamily(const TBuiltInFunctionFamilies& families, const TString& name,
+                                TBuiltInFunctionFamily& family, TInfoSink* infoSink);
+
 class TSymbolTableLevel {
 public:
     POOL_ALLOCATOR_NEW_DELETE(GetThreadPoolAllocator())
-    TSymbolTableLevel() : defaultPrecision(nullptr), anonId(0), thisLevel(false) { }
+    TSymbolTableLevel() : defaultPrecision(nullptr), anonId(0), thisLevel(false), deferredFunctions(nullptr) { }
     ~TSymbolTableLevel();
 
     bool insert(const TString& name, TSymbol* symbol) {
@@ -483,16 +535,26 @@ public:
         retargetedSymbols.push_back({from, to});
     }
 
-    TSymbol* find(const TString& name) const
+    // 'infoSink' is where the compile looking is told of deferred built-ins that do not parse.
+    TSymbol* find(const TString& name, TInfoSink* infoSink = nullptr) const
     {
         tLevel::const_iterator it = level.find(name);
-        if (it == level.end())
-            return nullptr;
-        else
+        if (it != level.end())
             return (*it).second;
+
+        if (deferredFunctions != nullptr) {
+            size_t parenAt = name.find_first_of('(');
+            if (parenAt != name.npos) {
+                TSymbolTableLevel* functions = findFunctionFamily(TString(name, 0, parenAt), infoSink);
+                if (functions != nullptr)
+                    return functions->find(name);
+            }
+        }
+
+        return nullptr;
     }
 
-    void findFunctionNameList(const TString& name, TVector<const TFunction*>& list)
+    void findFunctionNameList(const TString& name, TVector<const TFunction*>& list, TInfoSink* infoSink = nullptr)
     {
         size_t parenAt = name.find_first_of('(');
         TString base(name, 0, parenAt + 1);
@@ -502,11 +564,20 @@ public:
         tLevel::const_iterator end = level.upper_bound(base);
         for (tLevel::const_iterator it = begin; it != end; ++it)
             list.push_back(it->second->getAsFunction());
+
+        if (deferredFunctions != nullptr) {
+            TSymbolTableLevel* functions = findFunctionFamily(TString(name, 0, parenAt), infoSink);
+            if (functions != nullptr)
+                functions->findFunctionNameList(name, list);
+        }
     }
 
     // See if there is already a function in the table having the given non-function-style name.
     bool hasFunctionName(const TString& name) const
     {
+        if (deferredFunctions != nullptr && deferredFunctions->families.count(name) != 0)
+            return true;
+
         tLevel::const_iterator candidate = level.lower_bound(name);
         if (candidate != level.end()) {
             const TString& candidateName = (*candidate).first;
@@ -544,9 +615,40 @@ public:
             }
         }
 
+        if (deferredFunctions != nullptr && deferredFunctions->families.count(name) != 0) {
+            variable = false;
+            return true;
+        }
+
         return false;
     }
 
+    // The level holding the built-in overloads of the non-mangled 'name', parsing them
+    // on first use; nullptr if this level has none, or they do not parse.
+    TSymbolTableLevel* findFunctionFamily(const TString& name, TInfoSink* infoSink = nullptr) const
+    {
+        TMap<TString, TBuiltInFunctionFamily*>::const_iterator it = deferredFunctions->families.find(name);
+        if (it == deferredFunctions->families.end())
+            return nullptr;
+
+        TBuiltInFunctionFamily& family = *it->second;
+        TSymbolTableLevel* functions = family.functions.load(std::memory_order_acquire);
+        if (functions == nullptr && deferredFunctions->context != nullptr) {
+            ParseBuiltInFunctionFamily(*deferredFunctions, name, family, infoSink);
+            functions = family.functions.load(std::memory_order_acquire);
+        }
+
+        return functions;
+    }
+
+    // Split the function prototypes out of 'builtIns' to parse on demand; returns the rest.
+    TString deferFunctions(const TString& builtIns, TBuiltInFunctionFamilies* families);
+    void setDeferredContext(TSymbolTable* context)
+    {
+        if (deferredFunctions != nullptr)
+            deferredFunctions->context = context;
+    }
+
     // Use this to do a lazy 'push' of precision defaults the first time
     // a precision statement is seen in a new scope.  Leave it at 0 for
     // when no push was needed.  Thus, it is not the current defaults,
@@ -599,11 +701,13 @@ protected:
     int anonId;
     bool thisLevel;  // True if this level of the symbol table is a structure scope containing member function
                      // that are supposed to see anonymous access to member variables.
+    TBuiltInFunctionFamilies* deferredFunctions;  // built-in prototypes not parsed yet
 };
 
 class TSymbolTable {
 public:
-    TSymbolTable() : uniqueId(0), noBuiltInRedeclarations(false), separateNameSpaces(false), adoptedLevels(0)
+    TSymbolTable() : uniqueId(0), noBuiltInRedeclarations(false), separateNameSpaces(false), adoptedLevels(0),
+                     infoSink(nullptr)
     {
         //
         // This symbol table cannot be used until push() is called.
@@ -629,6 +733,33 @@ public:
         separateNameSpaces = symTable.separateNameSpaces;
     }
 
+    // Adopt the levels of a shared table to parse more of its built-ins, under the rules
+    // in force when its built-ins were first parsed.
+    void adoptBuiltInLevels(TSymbolTable& symTable)
+    {
+        adoptLevels(symTable);
+        noBuiltInRedeclarations = false;
+        separateNameSpaces = false;
+    }
+
+    // Parse the function prototypes of 'builtIns' on demand; returns what to parse now.
+    TString deferFunctions(const TString& builtIns, TBuiltInFunctionFamilies* families)
+    {
+        return table[currentLevel()]->deferFunctions(builtIns, families);
+    }
+
+    // Once this table is shared, let its own levels parse their deferred prototypes against it.
+    void setDeferredContext()
+    {
+        for (unsigned int level = adoptedLevels; level < table.size(); ++level)
+            table[level]->setDeferredContext(this);
+    }
+
+    TSymbolTableLevel* cloneTopLevel() const { return table.back()->clone(); }
+
+    // Where a compile's lookups report deferred built-in prototypes that do not parse.
+    void setInfoSink(TInfoSink* sink) { infoSink = sink; }
+
     //
     // While level adopting is generic, the methods below enact a the following
     // convention for levels:
@@ -784,10 +915,12 @@ public:
         do {
             if (table[level]->isThisLevel())
                 ++thisDepth;
-            symbol = table[level]->find(name);
+            symbol = table[level]->find(name, infoSink);
             --level;
         } while (symbol == nullptr && level >= 0);
         level++;
+        GLSLANG_COUNT(ECounterSymbolFinds, 1);
+        GLSLANG_COUNT(ECounterSymbolLevelsProbed, currentLevel() - level + 1);
         if (builtIn)
             *builtIn = isBuiltInLevel(level);
         if (currentScope)
@@ -818,9 +951,11 @@ public:
         do {
             if (table[level]->isThisLevel())
                 ++thisDepth;
-            symbol = table[level]->find(name);
+            symbol = table[level]->find(name, infoSink);
             --level;
         } while (symbol == nullptr && level >= 0);
+        GLSLANG_COUNT(ECounterSymbolFinds, 1);
+        GLSLANG_COUNT(ECounterSymbolLevelsProbed, currentLevel() - level);
 
         if (! table[level + 1]->isThisLevel())
             thisDepth = 0;
@@ -851,19 +986,22 @@ public:
         builtIn = false;
         int level = currentLevel();
         do {
-            table[level]->findFunctionNameList(name, list);
+            table[level]->findFunctionNameList(name, list, infoSink);
             --level;
         } while (list.empty() && level >= globalLevel);
 
-        if (! list.empty())
+        if (! list.empty()) {
+            GLSLANG_COUNT(ECounterFunctionCandidates, list.size());
             return;
+        }
 
         // Gather across all built-in levels; they don't hide each other
         builtIn = true;
         do {
-            table[level]->findFunctionNameList(name, list);
+            table[level]->findFunctionNameList(name, list, infoSink);
             --level;
         } while (level >= 0);
+        GLSLANG_COUNT(ECounterFunctionCandidates, list.size());
     }
 
     void relateToOperator(const char* name, TOperator op)
@@ -946,6 +1084,7 @@ protected:
     bool noBuiltInRedeclarations;
     bool separateNameSpaces;
     unsigned int adoptedLevels;
+    TInfoSink* infoSink;
 };
 
 } // end namespace glslang
@@ -48,8 +48,8 @@
 //
 // 1. Traverse all code (live+dead) to find the explicitly provided bindings.
 //
-// 2. Traverse (just) the live code to determine which non-provided bindings
-//    require auto-numbering.  We do not auto-number dead ones.
+// 2. Determine, from what step 1 recorded, which non-provided bindings are in
+//    live code and require auto-numbering.  We do not auto-number dead ones.
 //
 // 3. Traverse all the code to apply the bindings:
 //    a. explicitly given bindings are offset according to their type
@@ -67,9 +67,83 @@ public:
       , inputList(inList)
       , outputList(outList)
       , uniformList(uniformList)
+      , liveEvents(nullptr)
+      , deadDepth(0)
     {
     }
 
+    //
+    // Gather all code (live+dead), and at the same time record, for each function and
+    // global initializer, the symbols and calls a live traversal would act on, outside
+    // of statically dead branches.  gatherLive() then finds the live subset from these
+    // records, so the tree is only walked once.
+    //
+    void gatherAll(TIntermNode* root)
+    {
+        assert(traverseAll);
+        buildGlobalIndex();
+
+        TIntermSequence& globals = root->getAsAggregate()->getSequence();
+        for (unsigned int f = 0; f < globals.size(); ++f) {
+            TIntermAggregate* global = globals[f]->getAsAggregate();
+            liveEvents = global != nullptr ? &recordedEvents[global] : nullptr;
+            globals[f]->traverse(this);
+        }
+        liveEvents = nullptr;
+    }
+
+    // Replay the records of gatherAll() in the order a live traversal from 'entryPoint'
+    // would visit them.
+    void gatherLive(const TString& entryPoint)
+    {
+        traverseAll = false;
+        pushFunction(entryPoint);
+        while (! destinations.empty()) {
+            TIntermAggregate* destination = destinations.back();
+            destinations.pop_back();
+            auto events = recordedEvents.find(destination);
+            if (events == recordedEvents.end())
+                continue;
+            for (TIntermNode* event : events->second) {
+                if (TIntermSymbol* symbol = event->getAsSymbolNode())
+                    visitSymbol(symbol);
+                else
+                    addFunctionCall(event->getAsAggregate());
+            }
+        }
+    }
+
+    virtual bool visitAggregate(TVisit visit, TIntermAggregate* node)
+    {
+        if (recording() && visit == EvPreVisit && node->getOp() == EOpFunctionCall)
+            liveEvents->push_back(node);
+
+        return TLiveTraverser::visitAggregate(visit, node);
+    }
+
+    virtual bool visitSelection(TVisit visit, TIntermSelection* node)
+    {
+        TIntermConstantUnion* constant = node->getCondition()->getAsConstantUnion();
+        if (! traverseAll || constant == nullptr)
+            return TLiveTraverser::visitSelection(visit, node);
+
+        // gather both paths, but don't record the dead one
+        const bool condition = constant->getConstArray()[0].getBConst();
+        node->getCondition()->traverse(this);
+        if (node->getTrueBlock()) {
+            deadDepth += condition ? 0 : 1;
+            node->getTrueBlock()->traverse(this);
+            deadDepth -= condition ? 0 : 1;
+        }
+        if (node->getFalseBlock()) {
+            deadDepth += condition ? 1 : 0;
+            node->getFalseBlock()->traverse(this);
+            deadDepth -= condition ? 1 : 0;
+        }
+
+        return false;
+    }
+
     virtual void visitSymbol(TIntermSymbol* base)
     {
         TVarLiveMap* target = nullptr;
@@ -81,8 +155,15 @@ public:
             target = &uniformList;
         // If a global is being visited, then we should also traverse it incase it's evaluation
         // ends up visiting inputs we want to tag as live
-        else if (base->getQualifier().storage == EvqGlobal)
-            addGlobalReference(base->getAccessName());
+        else if (base->getQualifier().storage == EvqGlobal) {
+            if (! traverseAll)
+                addGlobalReference(base->getAccessName());
+            else if (recording())
+                liveEvents->push_back(base);
+        }
+
+        if (target && recording())
+            liveEvents->push_back(base);
 
         if (target) {
             TVarEntryInfo ent = {base->getId(), base, ! traverseAll, {}, {}, {}, {}, {}, {}, {}};
@@ -97,9 +178,15 @@ public:
     }
 
 private:
+    bool recording() const { return liveEvents != nullptr && deadDepth == 0; }
+
     TVarLiveMap&    inputList;
     TVarLiveMap&    outputList;
     TVarLiveMap&    uniformList;
+    typedef std::vector<TIntermNode*> TLiveEvents;
+    std::unordered_map<const TIntermAggregate*, TLiveEvents> recordedEvents;
+    TLiveEvents*    liveEvents;  // where gatherAll() records the current function or global initializer
+    int             deadDepth;   // > 0 inside a statically dead branch
 };
 
 class TVarSetTraverser : public TLiveTraverser
@@ -782,36 +869,50 @@ bool TDefaultIoResolverBase::doAutoBindingMapping() const { return referenceInte
 
 bool TDefaultIoResolverBase::doAutoLocationMapping() const { return referenceIntermediate.getAutoMapLocations(); }
 
+// the first range holding 'slot' or lying after it
 TDefaultIoResolverBase::TSlotSet::iterator TDefaultIoResolverBase::findSlot(int set, int slot) {
-    return std::lower_bound(slots[set].begin(), slots[set].end(), slot);
+    TSlotSet& slotSet = slots[set];
+    TSlotSet::iterator at = slotSet.upper_bound(slot);
+    if (at != slotSet.begin() && std::prev(at)->second > slot)
+        --at;
+    return at;
 }
 
 bool TDefaultIoResolverBase::checkEmpty(int set, int slot) {
     TSlotSet::iterator at = findSlot(set, slot);
-    return ! (at != slots[set].end() && *at == slot);
+    return ! (at != slots[set].end() && at->first <= slot);
 }
 
 int TDefaultIoResolverBase::reserveSlot(int set, int slot, int size) {
-    TSlotSet::iterator at = findSlot(set, slot);
-    // tolerate aliasing, by not double-recording aliases
+    TSlotSet& slotSet = slots[set];
+    if (size <= 0)
+        return slot;
+
+    // tolerate aliasing, by merging with whatever ranges overlap or touch the new one
     // (policy about appropriateness of the alias is higher up)
-    for (int i = 0; i < size; i++) {
-        if (at == slots[set].end() || *at != slot + i)
-            at = slots[set].insert(at, slot + i);
-        ++at;
+    int first = slot;
+    int last = slot + size;
+    TSlotSet::iterator at = slotSet.upper_bound(first);
+    if (at != slotSet.begin() && std::prev(at)->second >= first) {
+        --at;
+        first = at->first;
+    }
+    while (at != slotSet.end() && at->first <= last) {
+        last = std::max(last, at->second);
+        at = slotSet.erase(at);
     }
+    slotSet.emplace_hint(at, first, last);
+
     return slot;
 }
 
 int TDefaultIoResolverBase::getFreeSlot(int set, int base, int size) {
     TSlotSet::iterator at = findSlot(set, base);
-    if (at == slots[set].end())
-        return reserveSlot(set, base, size);
-    // look for a big enough gap
+    // look for the first big enough gap
     for (; at != slots[set].end(); ++at) {
-        if (*at - base >= size)
+        if (at->first - base >= size)
             break;
-        base = *at + 1;
+        base = std::max(base, at->second);
     }
     return reserveSlot(set, base, size);
 }
@@ -1436,15 +1537,9 @@ bool TIoMapper::addStage(EShLanguage stage, TIntermediate& intermediate, TInfoSi
 
     TVarLiveMap inVarMap, outVarMap, uniformVarMap;
     TVarLiveVector inVector, outVector, uniformVector;
-    TVarGatherTraverser iter_binding_all(intermediate, true, inVarMap, outVarMap, uniformVarMap);
-    TVarGatherTraverser iter_binding_live(intermediate, false, inVarMap, outVarMap, uniformVarMap);
-    root->traverse(&iter_binding_all);
-    iter_binding_live.pushFunction(intermediate.getEntryPointMangledName().c_str());
-    while (! iter_binding_live.destinations.empty()) {
-        TIntermNode* destination = iter_binding_live.destinations.back();
-        iter_binding_live.destinations.pop_back();
-        destination->traverse(&iter_binding_live);
-    }
+    TVarGatherTraverser iter_binding(intermediate, true, inVarMap, outVarMap, uniformVarMap);
+    iter_binding.gatherAll(root);
+    iter_binding.gatherLive(intermediate.getEntryPointMangledName().c_str());
 
     // sort entries by priority. see TVarEntryInfo::TOrderByPriority for info.
     for (auto& var : inVarMap) { inVector.push_back(var); }
@@ -1544,17 +1639,10 @@ bool TGlslIoMapper::addStage(EShLanguage stage, TIntermediate& intermediate, TIn
 #endif
     resolver->addStage(stage, intermediate);
     inVarMaps[stage] = new TVarLiveMap(); outVarMaps[stage] = new TVarLiveMap(); uniformVarMap[stage] = new TVarLiveMap();
-    TVarGatherTraverser iter_binding_all(intermediate, true, *inVarMaps[stage], *outVarMaps[stage],
-                                         *uniformVarMap[stage]);
-    TVarGatherTraverser iter_binding_live(intermediate, false, *inVarMaps[stage], *outVarMaps[stage],
-                                          *uniformVarMap[stage]);
-    root->traverse(&iter_binding_all);
-    iter_binding_live.pushFunction(intermediate.getEntryPointMangledName().c_str());
-    while (! iter_binding_live.destinations.empty()) {
-        TIntermNode* destination = iter_binding_live.destinations.back();
-        iter_binding_live.destinations.pop_back();
-        destination->traverse(&iter_binding_live);
-    }
+    TVarGatherTraverser iter_binding(intermediate, true, *inVarMaps[stage], *outVarMaps[stage],
+                                     *uniformVarMap[stage]);
+    iter_binding.gatherAll(root);
+    iter_binding.gatherLive(intermediate.getEntryPointMangledName().c_str());
 
     TNotifyInOutAdaptor inOutNotify(stage, *resolver);
     TNotifyUniformAdaptor uniformNotify(stage, *resolver);
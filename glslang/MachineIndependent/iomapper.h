@@ -38,6 +38,7 @@
 
 #include <cstdint>
 #include "LiveTraverser.h"
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 //
@@ -131,7 +132,8 @@ struct TVarEntryInfo {
 struct TDefaultIoResolverBase : public glslang::TIoMapResolver {
 public:
     TDefaultIoResolverBase(const TIntermediate& intermediate);
-    typedef std::vector<int> TSlotSet;
+    // occupied slots, as disjoint, non-adjacent ranges [first, second)
+    typedef std::map<int, int> TSlotSet;
     typedef std::unordered_map<int, TSlotSet> TSlotSetMap;
 
     // grow the reflection stage by stage
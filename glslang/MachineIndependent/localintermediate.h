@@ -46,6 +46,7 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <list>
 #include <set>
 #include <string>
 #include <vector>
@@ -947,9 +948,12 @@ public:
         return true;
     }
     int getPrimitives() const { return primitives; }
-    const char* addSemanticName(const TString& name)
+    const char* addSemanticName(const char* name)
     {
-        return semanticNameSet.insert(name).first->c_str();
+        auto it = semanticNameSet.find(name);
+        if (it == semanticNameSet.end())
+            it = semanticNameSet.insert(TString(name)).first;
+        return it->c_str();
     }
     void addUniformLocationOverride(const char* nameStr, int location)
     {
@@ -1078,10 +1082,22 @@ public:
     void setNanMinMaxClamp(bool setting) { nanMinMaxClamp = setting; }
     bool getNanMinMaxClamp() const { return nanMinMaxClamp; }
 
+    // The names this compile's source locations refer to
+    TSourceNames& getSourceNames() { return sourceNames; }
     void setSourceFile(const char* file) { if (file != nullptr) sourceFile = file; }
     const std::string& getSourceFile() const { return sourceFile; }
-    void addSourceText(const char* text, size_t len) { sourceText.append(text, len); }
-    const std::string& getSourceText() const { return sourceText; }
+    // The source text is a list of pieces, each either copied by addSourceText() or, when the
+    // caller keeps it alive for as long as this intermediate, referenced by referenceSourceText().
+    typedef std::vector<std::pair<const char*, size_t>> TSourceText;
+    void setSourceTextRetained(bool retained) { sourceTextRetained = retained; }
+    bool getSourceTextRetained() const { return sourceTextRetained; }
+    void addSourceText(const char* text, size_t len)
+    {
+        sourceTextCopies.emplace_back(text, len);
+        referenceSourceText(sourceTextCopies.back().data(), len);
+    }
+    void referenceSourceText(const char* text, size_t len) { sourceText.emplace_back(text, len); }
+    const TSourceText& getSourceText() const { return sourceText; }
     const std::map<std::string, std::string>& getIncludeText() const { return includeText; }
     void addIncludeText(const char* name, const char* text, size_t len) { includeText[name].assign(text,len); }
     void addProcesses(const std::vector<std::string>& p)
@@ -1238,7 +1254,7 @@ protected:
     bool hlslIoMapping;
     bool useVariablePointers;
 
-    std::set<TString> semanticNameSet;
+    std::set<TString, std::less<>> semanticNameSet;
 
     EShTextureSamplerTransformMode textureSamplerTransformMode;
 
@@ -1269,9 +1285,13 @@ protected:
     // set of names of statically read/written I/O that might need extra checking
     std::set<TString> ioAccessed;
 
+    TSourceNames sourceNames;
+
     // source code of shader, useful as part of debug information
     std::string sourceFile;
-    std::string sourceText;
+    TSourceText sourceText;
+    std::list<std::string> sourceTextCopies;  // backs the pieces that were copied
+    bool sourceTextRetained = false;
 
     // Included text. First string is a name, second is the included text
     std::map<std::string, std::string> includeText;
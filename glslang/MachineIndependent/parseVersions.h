@@ -148,7 +148,7 @@ public:
     const TSourceLoc& getCurrentLoc() const { return currentScanner->getSourceLoc(); }
     void setCurrentLine(int line) { currentScanner->setLine(line); }
     void setCurrentColumn(int col) { currentScanner->setColumn(col); }
-    void setCurrentSourceName(const char* name) { currentScanner->setFile(name); }
+    void setCurrentSourceName(int nameIndex) { currentScanner->setFile(nameIndex); }
     void setCurrentString(int string) { currentScanner->setString(string); }
 
     void getPreamble(std::string&);
@@ -82,6 +82,7 @@ NVIDIA HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <sstream>
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
@@ -208,6 +209,7 @@ int TPpContext::CPPdefine(TPpToken* ppToken)
         *existing = mac;
     } else
         addMacroDef(defAtom, mac);
+    invalidateExpansions(defAtom);
 
     return '\n';
 }
@@ -224,9 +226,11 @@ int TPpContext::CPPundef(TPpToken* ppToken)
 
     parseContext.reservedPpErrorCheck(ppToken->loc, ppToken->name, "#undef");
 
-    MacroSymbol* macro = lookupMacroDef(atomStrings.getAtom(ppToken->name));
+    const int undefAtom = atomStrings.getAtom(ppToken->name);
+    MacroSymbol* macro = lookupMacroDef(undefAtom);
     if (macro != nullptr)
         macro->undef = 1;
+    invalidateExpansions(undefAtom);
     token = scanToken(ppToken);
     if (token != '\n')
         parseContext.ppError(ppToken->loc, "can only be followed by a single macro name", "#undef", "");
@@ -742,7 +746,7 @@ int TPpContext::CPPline(TPpToken* ppToken)
                 // to the name field of the token since the name field
                 // will likely be overwritten by the next token scan.
                 sourceName = atomStrings.getString(atomStrings.getAddAtom(ppToken->name));
-                parseContext.setCurrentSourceName(sourceName);
+                parseContext.setCurrentSourceName(parseContext.intermediate.getSourceNames().getIndex(sourceName));
                 hasFile = true;
                 token = scanToken(ppToken);
             } else {
@@ -1163,6 +1167,128 @@ int TPpContext::tZeroInput::scan(TPpToken* ppToken)
     return PpAtomConstInt;
 }
 
+//
+// Return the full expansion of object-like macro 'macro', computing it in
+// isolation on first use and replaying it on later uses, until a #define or
+// #undef of any identifier it looked at invalidates it.
+//
+// Returns nullptr when the expansion cannot be computed in isolation, in which
+// case the caller expands the macro the regular way.
+//
+TPpContext::TokenStream* TPpContext::expandObjectMacro(int macroAtom, MacroSymbol* macro)
+{
+    auto cached = macroExpansions.find(macroAtom);
+    if (cached != macroExpansions.end() && cached->second.reusable) {
+        if (expansionDependencies != nullptr)
+            expansionDependencies->insert(expansionDependencies->end(), cached->second.dependencies.begin(),
+                                          cached->second.dependencies.end());
+        return &cached->second.tokens;
+    }
+
+    // the marker bounding the expansion must not be reached while looking for
+    // the rest of a function-like macro call, or an error would be reported
+    TVector<const MacroSymbol*> visited;
+    if (! selfContainedMacro(*macro, visited))
+        return nullptr;
+
+    MacroExpansion& expansion = macroExpansions[macroAtom];
+    expansion.tokens = TokenStream();
+    expansion.dependencies.clear();
+    expansion.dependencies.push_back(macroAtom);
+
+    TVector<int>* outerDependencies = expansionDependencies;
+    const bool outerReusable = expansionReusable;
+    expansionDependencies = &expansion.dependencies;
+    expansionReusable = true;
+    const int errors = parseContext.getNumErrors();
+
+    // expand as PrescanMacroArg() does, bounded by a marker
+    tMacroInput* in = new tMacroInput(this);
+    in->mac = macro;
+    pushInput(new tMarkerInput(this));
+    pushInput(in);
+    macro->busy = 1;
+    macro->body.reset();
+
+    TPpToken ppToken;
+    int token;
+    while ((token = scanToken(&ppToken)) != tMarkerInput::marker && token != EndOfInput) {
+        if (token == PpAtomIdentifier) {
+            switch (MacroExpand(&ppToken, false, false)) {
+            case MacroExpandNotStarted:
+                break;
+            case MacroExpandError:
+                // toss the rest of the expansion by scanning until tMarkerInput
+                while ((token = scanToken(&ppToken)) != tMarkerInput::marker && token != EndOfInput)
+                    ;
+                break;
+            case MacroExpandStarted:
+            case MacroExpandUndef:
+                continue;
+            }
+        }
+        if (token == tMarkerInput::marker || token == EndOfInput)
+            break;
+        expansion.tokens.putToken(token, &ppToken);
+    }
+
+    // Errors are reported once per use, and __LINE__ and friends, or a macro
+    // painted blue by an enclosing expansion, depend on the point of use.
+    expansion.reusable = expansionReusable && token == tMarkerInput::marker &&
+                         parseContext.getNumErrors() == errors;
+
+    std::sort(expansion.dependencies.begin(), expansion.dependencies.end());
+    expansion.dependencies.erase(std::unique(expansion.dependencies.begin(), expansion.dependencies.end()),
+                                 expansion.dependencies.end());
+    if (expansion.reusable) {
+        for (int atom : expansion.dependencies)
+            macroExpansionUsers[atom].push_back(macroAtom);
+    }
+
+    expansionDependencies = outerDependencies;
+    if (outerDependencies != nullptr) {
+        outerDependencies->insert(outerDependencies->end(), expansion.dependencies.begin(),
+                                  expansion.dependencies.end());
+        expansionReusable = outerReusable && expansion.reusable;
+    } else
+        expansionReusable = true;
+
+    return &expansion.tokens;
+}
+
+// See if expanding 'macro' only looks at its own replacement list and those of
+// the macros it refers to, never at the tokens following it.
+bool TPpContext::selfContainedMacro(const MacroSymbol& macro, TVector<const MacroSymbol*>& visited)
+{
+    if (std::find(visited.begin(), visited.end(), &macro) != visited.end())
+        return true;
+    visited.push_back(&macro);
+
+    TVector<const char*> identifiers;
+    if (! macro.body.selfContained(identifiers))
+        return false;
+    for (const char* name : identifiers) {
+        const int atom = atomStrings.getAtom(name);
+        const MacroSymbol* nested = atom == 0 ? nullptr : lookupMacroDef(atom);
+        if (nested != nullptr && ! nested->undef && ! selfContainedMacro(*nested, visited))
+            return false;
+    }
+
+    return true;
+}
+
+// Forget the memoized expansions that depend on the definition of 'atom'.
+void TPpContext::invalidateExpansions(int atom)
+{
+    auto users = macroExpansionUsers.find(atom);
+    if (users == macroExpansionUsers.end())
+        return;
+
+    for (int user : users->second)
+        macroExpansions.erase(user);
+    macroExpansionUsers.erase(users);
+}
+
 //
 // Check a token to see if it is a macro that should be expanded:
 // - If it is, and defined, push a tInput that will produce the appropriate
@@ -1182,6 +1308,16 @@ MacroExpandResult TPpContext::MacroExpand(TPpToken* ppToken, bool expandUndef, b
     if (ppToken->fullyExpanded)
         return MacroExpandNotStarted;
 
+    // record what a memoized expansion depends on; undefined names need an
+    // atom too, in case they get defined later
+    if (expansionDependencies != nullptr) {
+        if (macroAtom == 0)
+            macroAtom = atomStrings.getAddAtom(ppToken->name);
+        if (macroAtom == PpAtomLineMacro || macroAtom == PpAtomFileMacro || macroAtom == PpAtomVersionMacro)
+            expansionReusable = false;
+        expansionDependencies->push_back(macroAtom);
+    }
+
     switch (macroAtom) {
     case PpAtomLineMacro:
         // Arguments which are macro have been replaced in the first stage.
@@ -1192,7 +1328,7 @@ MacroExpandResult TPpContext::MacroExpand(TPpToken* ppToken, bool expandUndef, b
         return MacroExpandStarted;
 
     case PpAtomFileMacro: {
-        if (parseContext.getCurrentLoc().name)
+        if (parseContext.getCurrentLoc().nameIndex != 0)
             parseContext.ppRequireExtensions(ppToken->loc, 1, &E_GL_GOOGLE_cpp_style_line_directive, "filename-based __FILE__");
         ppToken->ival = parseContext.getCurrentLoc().string;
         snprintf(ppToken->name, sizeof(ppToken->name), "%s", ppToken->loc.getStringNameOrNum().c_str());
@@ -1215,6 +1351,8 @@ MacroExpandResult TPpContext::MacroExpand(TPpToken* ppToken, bool expandUndef, b
     // no recursive expansions
     if (macro != nullptr && macro->busy) {
         ppToken->fullyExpanded = true;
+        if (expansionDependencies != nullptr)
+            expansionReusable = false;
         return MacroExpandNotStarted;
     }
 
@@ -1228,6 +1366,15 @@ MacroExpandResult TPpContext::MacroExpand(TPpToken* ppToken, bool expandUndef, b
         return MacroExpandUndef;
     }
 
+    // outside of #if expressions, replay the memoized expansion of object-like macros
+    if (! macro->functionLike && ! expandUndef && ! peekPasting()) {
+        if (TokenStream* expansion = expandObjectMacro(macroAtom, macro)) {
+            GLSLANG_COUNT(ECounterMacroExpansions, 1);
+            pushTokenStreamInput(*expansion, false, true);
+            return MacroExpandStarted;
+        }
+    }
+
     tMacroInput *in = new tMacroInput(this);
 
     TSourceLoc loc = ppToken->loc;  // in case we go to the next line before discovering the error
@@ -1337,6 +1484,7 @@ MacroExpandResult TPpContext::MacroExpand(TPpToken* ppToken, bool expandUndef, b
             in->expandedArgs[i] = PrescanMacroArg(*in->args[i], ppToken, newLineOkay);
     }
 
+    GLSLANG_COUNT(ECounterMacroExpansions, 1);
     pushInput(in);
     macro->busy = 1;
     macro->body.reset();
@@ -95,6 +95,9 @@ TPpContext::TPpContext(TParseContextBase& pc, const std::string& rootFileName, T
         elseSeen[elsetracker] = false;
     elsetracker = 0;
 
+    expansionDependencies = nullptr;
+    expansionReusable = true;
+
     strtodStream.imbue(std::locale::classic());
 }
 
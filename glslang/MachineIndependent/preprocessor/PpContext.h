@@ -79,11 +79,13 @@ NVIDIA HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef PPCONTEXT_H
 #define PPCONTEXT_H
 
+#include <cstring>
 #include <stack>
 #include <unordered_map>
 #include <sstream>
 
 #include "../ParseHelper.h"
+#include "../../Include/Counters.h"
 #include "PpTokens.h"
 
 namespace glslang {
@@ -248,31 +250,34 @@ public:
     class TokenStream {
     public:
         // Manage a stream of these 'Token', which capture the relevant parts
-        // of a TPpToken, plus its atom.
+        // of a TPpToken, plus its atom.  Spellings are not held per token, but
+        // packed one after another into the stream's 'names' buffer.
         class Token {
         public:
-            Token(int atom, const TPpToken& ppToken) : 
+            Token(int atom, const TPpToken& ppToken, unsigned nameOffset) :
                 atom(atom),
                 space(ppToken.space),
-                i64val(ppToken.i64val),
-                name(ppToken.name) { }
-            int get(TPpToken& ppToken)
+                nameOffset(nameOffset),
+                i64val(ppToken.i64val) { }
+            int get(TPpToken& ppToken, const char* names) const
             {
                 ppToken.clear();
                 ppToken.space = space;
                 ppToken.i64val = i64val;
-                snprintf(ppToken.name, sizeof(ppToken.name), "%s", name.c_str());
+                const char* name = getName(names);
+                memcpy(ppToken.name, name, strlen(name) + 1);
                 return atom;
             }
             bool isAtom(int a) const { return atom == a; }
             int getAtom() const { return atom; }
             bool nonSpaced() const { return !space; }
+            const char* getName(const char* names) const { return names + nameOffset; }
         protected:
             Token() {}
             int atom;
-            bool space;        // did a space precede the token?
+            unsigned space      : 1;   // did a space precede the token?
+            unsigned nameOffset : 31;  // spelling, within the stream's 'names'
             long long i64val;
-            TString name;
         };
 
         TokenStream() : currentPos(0) { }
@@ -313,9 +318,11 @@ public:
         bool peekTokenizedPasting(bool lastTokenPastes);
         bool peekUntokenizedPasting();
         void reset() { currentPos = 0; }
+        bool selfContained(TVector<const char*>& identifiers) const;
 
     protected:
         TVector<Token> stream;
+        TVector<char> names;  // nul-terminated spellings; offset 0 is the empty name
         size_t currentPos;
     };
 
@@ -341,6 +348,18 @@ public:
     }
     void addMacroDef(int atom, MacroSymbol& macroDef) { macroDefs[atom] = macroDef; }
 
+    // Memoized expansions of object-like macros, see expandObjectMacro().
+    struct MacroExpansion {
+        MacroExpansion() : reusable(false) { }
+        TokenStream tokens;         // fully expanded replacement list
+        TVector<int> dependencies;  // atoms whose (re)definition invalidates 'tokens'
+        bool reusable;
+    };
+    TMap<int, MacroExpansion> macroExpansions;
+    TUnorderedMap<int, TVector<int>> macroExpansionUsers;  // dependency atom -> memoized macro atoms
+    TVector<int>* expansionDependencies;  // non-null while an expansion is being memoized
+    bool expansionReusable;
+
 protected:
     TPpContext(TPpContext&);
     TPpContext& operator=(TPpContext&);
@@ -363,6 +382,7 @@ protected:
     // Return EndOfInput when there are no more tokens to be found by doing this.
     int scanToken(TPpToken* ppToken)
     {
+        GLSLANG_COUNT(ECounterTokensScanned, 1);
         int token = EndOfInput;
 
         while (! inputStack.empty()) {
@@ -495,6 +515,9 @@ protected:
     int scanHeaderName(TPpToken* ppToken, char delimit);
     TokenStream* PrescanMacroArg(TokenStream&, TPpToken*, bool newLineOkay);
     MacroExpandResult MacroExpand(TPpToken* ppToken, bool expandUndef, bool newLineOkay);
+    TokenStream* expandObjectMacro(int macroAtom, MacroSymbol* macro);
+    bool selfContainedMacro(const MacroSymbol& macro, TVector<const MacroSymbol*>& visited);
+    void invalidateExpansions(int atom);
 
     //
     // From PpTokens.cpp
@@ -651,9 +674,10 @@ protected:
               scanner.setLine(startLoc.line);
               scanner.setString(startLoc.string);
 
-              scanner.setFile(startLoc.getFilenameStr(), 0);
-              scanner.setFile(startLoc.getFilenameStr(), 1);
-              scanner.setFile(startLoc.getFilenameStr(), 2);
+              const int nameIndex = pp->parseContext.intermediate.getSourceNames().getIndex(startLoc.getFilenameStr());
+              scanner.setFile(nameIndex, 0);
+              scanner.setFile(nameIndex, 1);
+              scanner.setFile(nameIndex, 2);
         }
 
         // tInput methods:
@@ -100,8 +100,17 @@ namespace glslang {
 // token stream, for later playback.
 void TPpContext::TokenStream::putToken(int atom, TPpToken* ppToken)
 {
-    TokenStream::Token streamToken(atom, *ppToken);
-    stream.push_back(streamToken);
+    if (names.empty())
+        names.push_back('\0');
+
+    unsigned nameOffset = 0;
+    const size_t nameLength = strlen(ppToken->name);
+    if (nameLength > 0) {
+        nameOffset = (unsigned)names.size();
+        names.insert(names.end(), ppToken->name, ppToken->name + nameLength + 1);
+    }
+
+    stream.push_back(Token(atom, *ppToken, nameOffset));
 }
 
 // Read the next token from a macro token stream.
@@ -110,7 +119,7 @@ int TPpContext::TokenStream::getToken(TParseContextBase& parseContext, TPpToken
     if (atEnd())
         return EndOfInput;
 
-    int atom = stream[currentPos++].get(*ppToken);
+    int atom = stream[currentPos++].get(*ppToken, names.data());
     ppToken->loc = parseContext.getCurrentLoc();
 
     // Check for ##, unless the current # is the last character
@@ -126,6 +135,39 @@ int TPpContext::TokenStream::getToken(TParseContextBase& parseContext, TPpToken
     return atom;
 }
 
+// True if expanding the stream cannot read past its end: it holds no '#'
+// and its parentheses and braces nest properly. The names of identifiers are
+// appended to 'identifiers', so the caller can check macros they refer to.
+bool TPpContext::TokenStream::selfContained(TVector<const char*>& identifiers) const
+{
+    TVector<int> nestStack;
+    for (const Token& token : stream) {
+        switch (token.getAtom()) {
+        case '#':
+            return false;
+        case '(':
+            nestStack.push_back(')');
+            break;
+        case '{':
+            nestStack.push_back('}');
+            break;
+        case ')':
+        case '}':
+            if (nestStack.empty() || nestStack.back() != token.getAtom())
+                return false;
+            nestStack.pop_back();
+            break;
+        case PpAtomIdentifier:
+            identifiers.push_back(token.getName(names.data()));
+            break;
+        default:
+            break;
+        }
+    }
+
+    return nestStack.empty();
+}
+
 // We are pasting if
 //   1. we are preceding a pasting operator within this stream
 // or
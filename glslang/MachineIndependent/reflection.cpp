@@ -34,18 +34,23 @@
 //
 
 #include "../Include/Common.h"
+#include "../Public/ReflectionBinary.h"
 #include "reflection.h"
 #include "LiveTraverser.h"
 #include "localintermediate.h"
 
 #include "gl_types.h"
 
+#include <thread>
+
 //
 // Grow the reflection database through a friend traverser class of TReflection and a
 // collection of functions to do a liveness traversal that note what uniforms are used
 // in semantically non-dead code.
 //
 // Can be used multiple times, once per stage, to grow a program reflection.
+// Stages can also be traversed concurrently into partial reflections of their own,
+// which are then merged in stage order; see TReflection::addStages().
 //
 // High-level algorithm for one stage:
 //
@@ -1176,18 +1181,17 @@ void TReflection::buildUniformStageMask(const TIntermediate& intermediate)
     }
 }
 
-// Merge live symbols from 'intermediate' into the existing reflection database.
-//
-// Returns false if the input is too malformed to do this.
-bool TReflection::addStage(EShLanguage stage, const TIntermediate& intermediate)
+// Is 'intermediate' well-formed enough to reflect?
+bool TReflection::canReflect(const TIntermediate& intermediate)
 {
-    if (intermediate.getTreeRoot() == nullptr ||
-        intermediate.getNumEntryPoints() != 1 ||
-        intermediate.isRecursive())
-        return false;
-
-    buildAttributeReflection(stage, intermediate);
+    return intermediate.getTreeRoot() != nullptr &&
+           intermediate.getNumEntryPoints() == 1 &&
+           ! intermediate.isRecursive();
+}
 
+// Add the live symbols of one stage to the database.
+void TReflection::traverseStage(const TIntermediate& intermediate)
+{
     TReflectionTraverser it(intermediate, *this);
 
     for (auto& sequnence : intermediate.getTreeRoot()->getAsAggregate()->getSequence()) {
@@ -1231,13 +1235,153 @@ bool TReflection::addStage(EShLanguage stage, const TIntermediate& intermediate)
         }
     }
     it.updateStageMasks = true;
+}
 
+// Merge live symbols from 'intermediate' into the existing reflection database.
+//
+// Returns false if the input is too malformed to do this.
+bool TReflection::addStage(EShLanguage stage, const TIntermediate& intermediate)
+{
+    if (! canReflect(intermediate))
+        return false;
+
+    buildAttributeReflection(stage, intermediate);
+    traverseStage(intermediate);
     buildCounterIndices(intermediate);
     buildUniformStageMask(intermediate);
 
     return true;
 }
 
+// Merge a partial reflection, holding what traverseStage() found in one stage alone, as
+// if that traversal had been made into this database: names new to this database are
+// appended in the order the stage found them, while known names only pick up the stage's
+// mask bits and any larger array size.  Block indexes recorded in the partial reflection
+// are translated to this database's.
+void TReflection::mergeStage(const TReflection& partial)
+{
+    const auto mergeBlocks = [this](const TMapIndexToReflection& from, TMapIndexToReflection& to) {
+        TIndices remap(from.size());
+        for (size_t b = 0; b < from.size(); ++b) {
+            TNameToIndex::const_iterator it = nameToIndex.find(from[b].name);
+            if (it == nameToIndex.end()) {
+                remap[b] = (int)to.size();
+                nameToIndex[from[b].name] = remap[b];
+                to.push_back(from[b]);
+                to.back().index = remap[b];
+            } else {
+                remap[b] = it->second;
+                if (it->second < (int)to.size())
+                    to[it->second].stages = static_cast<EShLanguageMask>(to[it->second].stages | from[b].stages);
+            }
+        }
+        return remap;
+    };
+    const TIndices uniformBlockRemap = mergeBlocks(partial.indexToUniformBlock, indexToUniformBlock);
+    const TIndices bufferBlockRemap = mergeBlocks(partial.indexToBufferBlock, indexToBufferBlock);
+
+    std::vector<bool> atomic(partial.indexToUniform.size());
+    for (int index : partial.atomicCounterUniformIndices)
+        atomic[index] = true;
+
+    const auto mergeVariables = [&](const TMapIndexToReflection& from, TMapIndexToReflection& to,
+                                    const TIndices& blockRemap, bool uniforms) {
+        for (size_t v = 0; v < from.size(); ++v) {
+            TNameToIndex::const_iterator it = nameToIndex.find(from[v].name);
+            if (it == nameToIndex.end()) {
+                const int index = (int)to.size();
+                nameToIndex[from[v].name] = index;
+                to.push_back(from[v]);
+                if (from[v].index >= 0 && from[v].index < (int)blockRemap.size())
+                    to.back().index = blockRemap[from[v].index];
+                if (uniforms && atomic[v])
+                    atomicCounterUniformIndices.push_back(index);
+            } else if (it->second < (int)to.size()) {
+                TObjectReflection& variable = to[it->second];
+                if (from[v].size > 1)
+                    variable.size = std::max(from[v].size, variable.size);
+                variable.stages = static_cast<EShLanguageMask>(variable.stages | from[v].stages);
+            }
+        }
+    };
+    mergeVariables(partial.indexToUniform, indexToUniform, uniformBlockRemap, true);
+    mergeVariables(partial.indexToBufferVariable, indexToBufferVariable, bufferBlockRemap, false);
+
+    // unwrapped I/O is named in nameToIndex, with an "in " or "out " prefix
+    const bool unwrap = (options & EShReflectionUnwrapIOBlocks) != 0;
+    const auto mergePipeIO = [&](const TMapIndexToReflection& from, TMapIndexToReflection& to,
+                                 TNameToIndex& ioMapper, const char* prefix) {
+        TNameToIndex& names = unwrap ? nameToIndex : ioMapper;
+        for (size_t i = 0; i < from.size(); ++i) {
+            const std::string name = unwrap ? prefix + from[i].name : from[i].name;
+            TNameToIndex::const_iterator it = names.find(name);
+            if (it == names.end()) {
+                names[name] = (int)to.size();
+                to.push_back(from[i]);
+            } else if (it->second < (int)to.size())
+                to[it->second].stages = static_cast<EShLanguageMask>(to[it->second].stages | from[i].stages);
+        }
+    };
+    mergePipeIO(partial.indexToPipeInput, indexToPipeInput, pipeInNameToIndex, "in ");
+    mergePipeIO(partial.indexToPipeOutput, indexToPipeOutput, pipeOutNameToIndex, "out ");
+}
+
+// Traverse each stage into a partial reflection of its own, all stages at once, then merge
+// them in stage order.  The first stage is traversed on the calling thread and the rest each
+// on a thread of its own, with a pool of its own that lives as long as this reflection.
+//
+// Returns false if a stage is too malformed to reflect, after adding the stages before it,
+// the same as a sequence of addStage() calls would.
+bool TReflection::addStages(TIntermediate* const intermediates[EShLangCount])
+{
+    int badStage = EShLangCount;
+    for (int s = 0; s < EShLangCount; ++s) {
+        if (intermediates[s] != nullptr && ! canReflect(*intermediates[s])) {
+            badStage = s;
+            break;
+        }
+    }
+
+    std::unique_ptr<TReflection> partials[EShLangCount];
+    std::vector<std::thread> threads;
+    int localStage = -1;
+    for (int s = 0; s < badStage; ++s) {
+        if (intermediates[s] == nullptr)
+            continue;
+
+        partials[s].reset(new TReflection(options, firstStage, lastStage));
+        if (localStage < 0) {
+            localStage = s;
+            continue;
+        }
+
+        TReflection* partial = partials[s].get();
+        const TIntermediate* intermediate = intermediates[s];
+        stagePools.emplace_back(new TPoolAllocator);
+        TPoolAllocator* pool = stagePools.back().get();
+        threads.emplace_back([partial, intermediate, pool]() {
+            SetThreadPoolAllocator(pool);
+            partial->traverseStage(*intermediate);
+        });
+    }
+    if (localStage >= 0)
+        partials[localStage]->traverseStage(*intermediates[localStage]);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (int s = 0; s < badStage; ++s) {
+        if (intermediates[s] == nullptr)
+            continue;
+
+        buildAttributeReflection((EShLanguage)s, *intermediates[s]);
+        mergeStage(*partials[s]);
+        buildCounterIndices(*intermediates[s]);
+        buildUniformStageMask(*intermediates[s]);
+    }
+
+    return badStage == EShLangCount;
+}
+
 void TReflection::dump()
 {
     printf("Uniform reflection:\n");
@@ -1286,4 +1430,101 @@ void TReflection::dump()
     // printf("\n");
 }
 
+// Serialize the database into the layout described in ReflectionBinary.h.
+void TReflection::getBinary(std::vector<unsigned int>& words) const
+{
+    const TMapIndexToReflection* sections[EReflectionSectionCount] = {
+        &indexToUniform, &indexToUniformBlock, &indexToBufferVariable,
+        &indexToBufferBlock, &indexToPipeInput, &indexToPipeOutput
+    };
+    const TNameToIndex* nameMaps[EReflectionNamesCount] = { &nameToIndex, &pipeInNameToIndex, &pipeOutNameToIndex };
+
+    // names are shared by records and name tables
+    std::string names;
+    std::unordered_map<std::string, uint32_t> nameOffsets;
+    const auto addName = [&](const std::string& name) -> uint32_t {
+        auto it = nameOffsets.find(name);
+        if (it != nameOffsets.end())
+            return it->second;
+        const uint32_t offset = (uint32_t)names.size();
+        names.append(name.c_str(), name.size() + 1);
+        nameOffsets[name] = offset;
+        return offset;
+    };
+
+    // lay out the sections
+    TReflectionBinaryHeader header = {};
+    header.magic = ReflectionBinaryMagic;
+    header.version = ReflectionBinaryVersion;
+    for (int dim = 0; dim < 3; ++dim)
+        header.localSize[dim] = localSize[dim];
+    uint32_t size = sizeof(header);
+    for (int s = 0; s < EReflectionSectionCount; ++s) {
+        header.sections[s] = { size, (uint32_t)sections[s]->size() };
+        size += header.sections[s].count * sizeof(TReflectionBinaryRecord);
+    }
+    header.atomicCounters = { size, (uint32_t)atomicCounterUniformIndices.size() };
+    size += header.atomicCounters.count * sizeof(int32_t);
+    for (int n = 0; n < EReflectionNamesCount; ++n) {
+        // keep the tables at most half full
+        uint32_t buckets = nameMaps[n]->empty() ? 0 : 2;
+        while (buckets < 2 * nameMaps[n]->size())
+            buckets *= 2;
+        header.nameTables[n] = { size, buckets };
+        size += buckets * sizeof(TReflectionBinaryNameEntry);
+    }
+
+    std::vector<TReflectionBinaryRecord> records;
+    for (int s = 0; s < EReflectionSectionCount; ++s) {
+        for (const TObjectReflection& object : *sections[s]) {
+            TReflectionBinaryRecord record;
+            record.name = addName(object.name);
+            record.offset = object.offset;
+            record.glDefineType = object.glDefineType;
+            record.size = object.size;
+            record.index = object.index;
+            record.counterIndex = object.counterIndex;
+            record.numMembers = object.numMembers;
+            record.arrayStride = object.arrayStride;
+            record.topLevelArraySize = object.topLevelArraySize;
+            record.topLevelArrayStride = object.topLevelArrayStride;
+            record.stages = (uint32_t)object.stages;
+            record.binding = object.getBinding();
+            record.location = object.getType() != nullptr ? object.layoutLocation() : TQualifier::layoutLocationEnd;
+            records.push_back(record);
+        }
+    }
+
+    std::vector<TReflectionBinaryNameEntry> entries;
+    for (int n = 0; n < EReflectionNamesCount; ++n) {
+        const size_t first = entries.size();
+        const uint32_t mask = header.nameTables[n].count - 1;
+        entries.resize(first + header.nameTables[n].count, { ReflectionBinaryNoName, -1 });
+        for (const auto& name : *nameMaps[n]) {
+            uint32_t slot = ReflectionBinaryHash(name.first.c_str()) & mask;
+            while (entries[first + slot].name != ReflectionBinaryNoName)
+                slot = (slot + 1) & mask;
+            entries[first + slot] = { addName(name.first), name.second };
+        }
+    }
+
+    names.resize((names.size() + 4) & ~(size_t)3, '\0');  // at least one nul, padded to a word
+    header.names = { size, (uint32_t)names.size() };
+    size += header.names.count;
+    header.size = size;
+
+    words.resize(size / sizeof(unsigned int));
+    char* image = reinterpret_cast<char*>(words.data());
+    const auto copy = [image](uint32_t offset, const void* data, size_t bytes) {
+        if (bytes > 0)
+            memcpy(image + offset, data, bytes);
+    };
+    copy(0, &header, sizeof(header));
+    copy(header.sections[0].offset, records.data(), records.size() * sizeof(TReflectionBinaryRecord));
+    copy(header.atomicCounters.offset, atomicCounterUniformIndices.data(),
+         atomicCounterUniformIndices.size() * sizeof(int32_t));
+    copy(header.nameTables[0].offset, entries.data(), entries.size() * sizeof(TReflectionBinaryNameEntry));
+    copy(header.names.offset, names.data(), names.size());
+}
+
 } // end namespace glslang
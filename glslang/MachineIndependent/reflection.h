@@ -40,7 +40,9 @@
 #include "../Include/Types.h"
 
 #include <list>
+#include <memory>
 #include <set>
+#include <vector>
 
 //
 // A reflection database and its interface, consistent with the OpenGL API reflection queries.
@@ -67,6 +69,10 @@ public:
     // grow the reflection stage by stage
     bool addStage(EShLanguage, const TIntermediate&);
 
+    // grow the reflection by all the given stages at once, traversing them concurrently;
+    // the result is the same as calling addStage() for each in order
+    bool addStages(TIntermediate* const intermediates[EShLangCount]);
+
     // for mapping a uniform index to a uniform object's description
     int getNumUniforms() { return (int)indexToUniform.size(); }
     const TObjectReflection& getUniform(int i) const
@@ -169,12 +175,18 @@ public:
 
     void dump();
 
+    // serialize to the binary layout of ReflectionBinary.h
+    void getBinary(std::vector<unsigned int>& words) const;
+
 protected:
     friend class glslang::TReflectionTraverser;
 
     void buildCounterIndices(const TIntermediate&);
     void buildUniformStageMask(const TIntermediate& intermediate);
     void buildAttributeReflection(EShLanguage, const TIntermediate&);
+    static bool canReflect(const TIntermediate&);
+    void traverseStage(const TIntermediate&);
+    void mergeStage(const TReflection& partial);
 
     // Need a TString hash: typedef std::unordered_map<TString, int> TNameToIndex;
     typedef std::map<std::string, int> TNameToIndex;
@@ -212,6 +224,9 @@ protected:
     TIndices atomicCounterUniformIndices;
 
     unsigned int localSize[3];
+
+    // hold the types of stages traversed on other threads; shared, so a copy keeps them too
+    std::vector<std::shared_ptr<TPoolAllocator>> stagePools;
 };
 
 } // end namespace glslang
@@ -0,0 +1,614 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _COMPILE_WORKER_INCLUDED_
+#define _COMPILE_WORKER_INCLUDED_
+
+//
+// Client side, and the wire format, of the standalone compiler's --worker mode.
+//
+// A worker listens on a local socket and serves each connection in a process of
+// its own, forked from the listener, so a compile that crashes ends only that
+// connection.  Built-in symbol tables stay warm across all jobs of a connection;
+// keep one open rather than connecting per job.
+//
+// Jobs go over the socket.  Results -- the log, and the SPIR-V of each module --
+// are written by the worker into a ring buffer the client shares with it when
+// connecting, and only their place in the ring comes back over the socket.  A
+// result that does not fit in the ring's free space comes over the socket instead.
+//
+// POSIX only.  Like the worker, the client does not need glslang to be linked.
+//
+
+#ifndef _WIN32
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace glslang {
+
+const uint32_t CompileWorkerMagic = 0x4b574c47;  // "GLWK"
+const uint32_t CompileWorkerVersion = 1;
+const uint64_t CompileWorkerInline = ~0ull;           // offset of a result sent over the socket
+const uint64_t CompileWorkerMaxMessage = 1ull << 30;  // larger messages are treated as corrupt
+
+enum TCompileWorkerMessageType {
+    ECompileWorkerHello,   // client to worker, once: the version; the ring's file descriptor rides along
+    ECompileWorkerJob,     // client to worker: a serialized TCompileWorkerJob
+    ECompileWorkerResult,  // worker to client: TCompileWorkerResultHeader, its modules, and inline data
+};
+
+enum TCompileWorkerStatus {
+    ECompileWorkerSuccess,
+    ECompileWorkerCompileFailed,
+    ECompileWorkerLinkFailed,
+    ECompileWorkerBadJob,        // the job could not be read, or has no sources
+    ECompileWorkerNoConnection,  // the worker could not be reached, or went away
+};
+
+struct TCompileWorkerMessageHeader {
+    uint32_t magic;
+    uint32_t type;  // TCompileWorkerMessageType
+    uint64_t size;  // of the payload that follows
+};
+
+// Start of the shared ring; 'capacity' bytes of data follow it.
+struct TCompileWorkerRing {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    std::atomic<uint64_t> head;  // bytes ever written by the worker
+    std::atomic<uint64_t> tail;  // bytes ever released by the client
+
+    char* getData() { return reinterpret_cast<char*>(this + 1); }
+};
+
+struct TCompileWorkerResultHeader {
+    uint32_t status;       // TCompileWorkerStatus
+    uint32_t moduleCount;  // of the TCompileWorkerModule that follow
+    uint64_t logSize;      // in bytes, without a nul
+    uint64_t offset;       // of the data in the ring, or CompileWorkerInline
+    uint64_t size;         // of the data: the log, padded to a word, then the words of each module
+    uint64_t ringEnd;      // the ring's head once the data is released
+};
+
+struct TCompileWorkerModule {
+    uint32_t stage;  // EShLanguage
+    uint32_t wordCount;
+};
+
+inline uint64_t CompileWorkerPad(uint64_t size, uint64_t alignment) { return (size + alignment - 1) & ~(alignment - 1); }
+
+//
+// One compile and link job, like a job of a --batch manifest, except that it carries
+// its sources.  The worker's command line applies to every job.
+//
+class TCompileWorkerJob {
+public:
+    struct Source {
+        std::string name;  // gives the stage, unless 'stage' does, and where "" includes are searched
+        std::string text;
+    };
+
+    std::vector<Source> sources;
+    std::string stage;
+    std::vector<std::string> defines;
+    std::string targetEnv;
+    std::string entryPoint;
+
+    void serialize(std::string& out) const
+    {
+        out.clear();
+        writeCount(out, sources.size());
+        for (const Source& source : sources) {
+            writeString(out, source.name);
+            writeString(out, source.text);
+        }
+        writeString(out, stage);
+        writeCount(out, defines.size());
+        for (const std::string& define : defines)
+            writeString(out, define);
+        writeString(out, targetEnv);
+        writeString(out, entryPoint);
+    }
+
+    // Returns false if 'data' is not a whole serialized job.
+    bool deserialize(const char* data, size_t size)
+    {
+        const char* end = data + size;
+        uint32_t count;
+        if (! readCount(data, end, count) || count > size)
+            return false;
+        sources.resize(count);
+        for (Source& source : sources) {
+            if (! readString(data, end, source.name) || ! readString(data, end, source.text))
+                return false;
+        }
+        if (! readString(data, end, stage) || ! readCount(data, end, count) || count > size)
+            return false;
+        defines.resize(count);
+        for (std::string& define : defines) {
+            if (! readString(data, end, define))
+                return false;
+        }
+
+        return readString(data, end, targetEnv) && readString(data, end, entryPoint) && data == end;
+    }
+
+protected:
+    static void writeCount(std::string& out, size_t count)
+    {
+        const uint32_t value = (uint32_t)count;
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static void writeString(std::string& out, const std::string& str)
+    {
+        writeCount(out, str.size());
+        out.append(str);
+    }
+
+    static bool readCount(const char*& data, const char* end, uint32_t& count)
+    {
+        if ((size_t)(end - data) < sizeof(count))
+            return false;
+        memcpy(&count, data, sizeof(count));
+        data += sizeof(count);
+        return true;
+    }
+
+    static bool readString(const char*& data, const char* end, std::string& str)
+    {
+        uint32_t size;
+        if (! readCount(data, end, size) || (size_t)(end - data) < size)
+            return false;
+        str.assign(data, size);
+        data += size;
+        return true;
+    }
+};
+
+//
+// What became of a job.  The log and the modules point into the ring until the result
+// is released, or into the result itself if it came over the socket.
+//
+class TCompileWorkerResult {
+public:
+    struct Module {
+        int stage;  // EShLanguage
+        const unsigned int* words;
+        size_t wordCount;
+    };
+
+    TCompileWorkerResult() : status(ECompileWorkerNoConnection), log(""), logSize(0), ringEnd(0), inRing(false) { }
+
+    TCompileWorkerStatus status;
+    const char* log;  // not nul-terminated
+    size_t logSize;
+    std::vector<Module> modules;
+
+    bool succeeded() const { return status == ECompileWorkerSuccess; }
+    std::string getLog() const { return std::string(log, logSize); }
+
+protected:
+    friend class TCompileWorkerClient;
+
+    uint64_t ringEnd;
+    bool inRing;
+    std::vector<uint64_t> inlineData;
+};
+
+//
+// Framing of the messages both sides send over the socket.  Does not own the socket.
+//
+class TCompileWorkerConnection {
+public:
+    explicit TCompileWorkerConnection(int fd) : fd(fd) { }
+
+    bool writeAll(const void* data, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            const ssize_t written = send(fd, bytes, size, sendFlags());
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                return false;
+            bytes += written;
+            size -= (size_t)written;
+        }
+        return true;
+    }
+
+    // False at the end of the stream, as well as on errors.
+    bool readAll(void* data, size_t size)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (size > 0) {
+            const ssize_t count = recv(fd, bytes, size, 0);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                return false;
+            bytes += count;
+            size -= (size_t)count;
+        }
+        return true;
+    }
+
+    bool writeHeader(TCompileWorkerMessageType type, uint64_t size)
+    {
+        const TCompileWorkerMessageHeader header = { CompileWorkerMagic, (uint32_t)type, size };
+        return writeAll(&header, sizeof(header));
+    }
+
+    bool readHeader(uint32_t& type, uint64_t& size)
+    {
+        TCompileWorkerMessageHeader header;
+        if (! readAll(&header, sizeof(header)) || header.magic != CompileWorkerMagic ||
+            header.size > CompileWorkerMaxMessage)
+            return false;
+        type = header.type;
+        size = header.size;
+        return true;
+    }
+
+    bool sendHello(int ringFd)
+    {
+        THello hello = { { CompileWorkerMagic, ECompileWorkerHello, sizeof(hello) - sizeof(hello.header) },
+                         CompileWorkerVersion, 0 };
+
+        iovec data = { &hello, sizeof(hello) };
+        union {
+            cmsghdr align;
+            char buffer[CMSG_SPACE(sizeof(int))];
+        } control;
+        memset(&control, 0, sizeof(control));
+        msghdr message = {};
+        message.msg_iov = &data;
+        message.msg_iovlen = 1;
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+        cmsghdr* rights = CMSG_FIRSTHDR(&message);
+        rights->cmsg_level = SOL_SOCKET;
+        rights->cmsg_type = SCM_RIGHTS;
+        rights->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(rights), &ringFd, sizeof(int));
+
+        ssize_t written;
+        do
+            written = sendmsg(fd, &message, sendFlags());
+        while (written < 0 && errno == EINTR);
+        if (written <= 0)
+            return false;
+
+        return writeAll(reinterpret_cast<const char*>(&hello) + written, sizeof(hello) - (size_t)written);
+    }
+
+    // Returns the ring's file descriptor, or -1 if the hello is missing or of another version.
+    int receiveHello()
+    {
+        THello hello;
+
+        iovec data = { &hello, sizeof(hello) };
+        union {
+            cmsghdr align;
+            char buffer[CMSG_SPACE(sizeof(int))];
+        } control;
+        msghdr message = {};
+        message.msg_iov = &data;
+        message.msg_iovlen = 1;
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+
+        ssize_t count;
+        do
+            count = recvmsg(fd, &message, 0);
+        while (count < 0 && errno == EINTR);
+        if (count <= 0)
+            return -1;
+
+        int ringFd = -1;
+        for (cmsghdr* c = CMSG_FIRSTHDR(&message); c != nullptr; c = CMSG_NXTHDR(&message, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS)
+                memcpy(&ringFd, CMSG_DATA(c), sizeof(int));
+        }
+        if (ringFd < 0)
+            return -1;
+
+        if (! readAll(reinterpret_cast<char*>(&hello) + count, sizeof(hello) - (size_t)count) ||
+            hello.header.magic != CompileWorkerMagic || hello.header.type != ECompileWorkerHello ||
+            hello.header.size != sizeof(hello) - sizeof(hello.header) || hello.version != CompileWorkerVersion) {
+            close(ringFd);
+            return -1;
+        }
+
+        return ringFd;
+    }
+
+protected:
+    struct THello {
+        TCompileWorkerMessageHeader header;
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    static int sendFlags()
+    {
+#ifdef MSG_NOSIGNAL
+        return MSG_NOSIGNAL;
+#else
+        return 0;  // SO_NOSIGPIPE is set on the socket
+#endif
+    }
+
+    int fd;
+};
+
+//
+// A connection to a worker.  Not thread safe; use a client per thread.
+//
+class TCompileWorkerClient {
+public:
+    static const size_t DefaultRingSize = 16 << 20;
+
+    TCompileWorkerClient() : fd(-1), ring(nullptr), mappedSize(0) { }
+    ~TCompileWorkerClient() { disconnect(); }
+
+    // Connects to the worker listening at 'socketPath', sharing a ring of 'ringSize' bytes.
+    bool connect(const char* socketPath, size_t ringSize = DefaultRingSize)
+    {
+        disconnect();
+
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (strlen(socketPath) >= sizeof(address.sun_path))
+            return false;
+        strcpy(address.sun_path, socketPath);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return false;
+#ifdef SO_NOSIGPIPE
+        const int noSigPipe = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            disconnect();
+            return false;
+        }
+
+        ringSize = (size_t)CompileWorkerPad(ringSize, 8);
+        const int ringFd = createSharedMemory(sizeof(TCompileWorkerRing) + ringSize);
+        if (ringFd < 0) {
+            disconnect();
+            return false;
+        }
+        void* mapping = mmap(nullptr, sizeof(TCompileWorkerRing) + ringSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                             ringFd, 0);
+        if (mapping == MAP_FAILED) {
+            close(ringFd);
+            disconnect();
+            return false;
+        }
+        mappedSize = sizeof(TCompileWorkerRing) + ringSize;
+        ring = new (mapping) TCompileWorkerRing;
+        ring->magic = CompileWorkerMagic;
+        ring->version = CompileWorkerVersion;
+        ring->capacity = ringSize;
+        ring->head.store(0);
+        ring->tail.store(0);
+
+        const bool sent = TCompileWorkerConnection(fd).sendHello(ringFd);
+        close(ringFd);  // the mappings on both sides keep the memory
+        if (! sent)
+            disconnect();
+
+        return sent;
+    }
+
+    void disconnect()
+    {
+        if (fd >= 0)
+            close(fd);
+        fd = -1;
+        if (ring != nullptr)
+            munmap(ring, mappedSize);
+        ring = nullptr;
+        mappedSize = 0;
+        pending.clear();
+    }
+
+    bool connected() const { return fd >= 0; }
+
+    // Sends a job, and waits for its result, first releasing whatever 'result' held.
+    // Returns false, disconnected, if the worker could not be reached or went away, as
+    // it does if the compile crashes; connect() again to carry on in a new process.
+    bool compile(const TCompileWorkerJob& job, TCompileWorkerResult& result)
+    {
+        std::string payload;
+        job.serialize(payload);
+
+        return compilePayload(payload, result);
+    }
+
+    // Gives the ring space of a result back to the worker.  Results may be released in
+    // any order; the space is reused once every earlier result is released too.
+    void release(TCompileWorkerResult& result)
+    {
+        if (! result.inRing)
+            return;
+        result.inRing = false;
+        result.log = "";
+        result.logSize = 0;
+        result.modules.clear();
+        if (ring == nullptr)
+            return;
+
+        for (auto& entry : pending) {
+            if (entry.first == result.ringEnd)
+                entry.second = true;
+        }
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        while (! pending.empty() && pending.front().second) {
+            tail = pending.front().first;
+            pending.pop_front();
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+protected:
+    TCompileWorkerClient(const TCompileWorkerClient&);
+    TCompileWorkerClient& operator=(const TCompileWorkerClient&);
+
+    // compile() of an already serialized job; whether it is a whole one is up to the worker
+    bool compilePayload(const std::string& payload, TCompileWorkerResult& result)
+    {
+        release(result);
+        result = TCompileWorkerResult();
+        if (! connected())
+            return false;
+
+        TCompileWorkerConnection connection(fd);
+        uint32_t type;
+        uint64_t size;
+        TCompileWorkerResultHeader header;
+        if (! connection.writeHeader(ECompileWorkerJob, payload.size()) ||
+            ! connection.writeAll(payload.data(), payload.size()) || ! connection.readHeader(type, size) ||
+            type != ECompileWorkerResult || size < sizeof(header) || ! connection.readAll(&header, sizeof(header)) ||
+            header.moduleCount > (size - sizeof(header)) / sizeof(TCompileWorkerModule)) {
+            disconnect();
+            return false;
+        }
+
+        std::vector<TCompileWorkerModule> modules(header.moduleCount);
+        const uint64_t modulesSize = header.moduleCount * sizeof(TCompileWorkerModule);
+        const uint64_t inlineSize = header.offset == CompileWorkerInline ? header.size : 0;
+        if (size != sizeof(header) + modulesSize + inlineSize || ! connection.readAll(modules.data(), (size_t)modulesSize)) {
+            disconnect();
+            return false;
+        }
+
+        const char* data;
+        if (header.offset == CompileWorkerInline) {
+            result.inlineData.resize((size_t)CompileWorkerPad(header.size, 8) / 8);
+            if (! connection.readAll(result.inlineData.data(), (size_t)header.size)) {
+                disconnect();
+                return false;
+            }
+            data = reinterpret_cast<const char*>(result.inlineData.data());
+        } else {
+            if (header.offset > ring->capacity || header.size > ring->capacity - header.offset) {
+                disconnect();
+                return false;
+            }
+            data = ring->getData() + header.offset;
+            result.inRing = true;
+            result.ringEnd = header.ringEnd;
+            pending.emplace_back(header.ringEnd, false);
+        }
+
+        // lay out the log and modules over the data
+        uint64_t dataSize = CompileWorkerPad(header.logSize, 4);
+        for (const TCompileWorkerModule& module : modules)
+            dataSize += module.wordCount * sizeof(unsigned int);
+        if (header.logSize > header.size || dataSize > header.size) {
+            release(result);
+            disconnect();
+            return false;
+        }
+        result.status = (TCompileWorkerStatus)header.status;
+        result.log = data;
+        result.logSize = (size_t)header.logSize;
+        const unsigned int* words = reinterpret_cast<const unsigned int*>(data + CompileWorkerPad(header.logSize, 4));
+        for (const TCompileWorkerModule& module : modules) {
+            result.modules.push_back({ (int)module.stage, words, module.wordCount });
+            words += module.wordCount;
+        }
+
+        return true;
+    }
+
+    // An anonymous file of 'size' bytes, to map on both sides
+    static int createSharedMemory(size_t size)
+    {
+#if defined(__linux__) && ! defined(__ANDROID__)
+        const int memory = memfd_create("glslang-worker-ring", MFD_CLOEXEC);
+#else
+        const char* directory = getenv("TMPDIR");
+        std::string path = std::string(directory != nullptr ? directory : "/tmp") + "/glslang-worker-XXXXXX";
+        const int memory = mkstemp(&path[0]);
+        if (memory >= 0)
+            unlink(path.c_str());
+#endif
+        if (memory < 0)
+            return -1;
+        if (ftruncate(memory, (off_t)size) != 0) {
+            close(memory);
+            return -1;
+        }
+
+        return memory;
+    }
+
+    int fd;
+    TCompileWorkerRing* ring;
+    size_t mappedSize;
+    std::deque<std::pair<uint64_t, bool>> pending;  // ring ends of results in the ring, oldest first
+};
+
+} // end namespace glslang
+
+#endif // _WIN32
+
+#endif // _COMPILE_WORKER_INCLUDED_
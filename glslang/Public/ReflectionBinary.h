@@ -0,0 +1,253 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef _REFLECTION_BINARY_INCLUDED_
+#define _REFLECTION_BINARY_INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//
+// Binary form of a reflection database, as written by TProgram::getReflectionBinary().
+//
+// The image is made of 32-bit words in the byte order of the writer, so a runtime
+// can map it straight from disk and read it in place with TReflectionBinary, without
+// linking glslang.  In order, it holds:
+//
+//   TReflectionBinaryHeader
+//   TReflectionBinaryRecord[]     the records of each section, one section after another
+//   int32_t[]                     uniform indices of the atomic counters
+//   TReflectionBinaryNameEntry[]  open-addressed hash tables from names to indices
+//   char[]                        nul-terminated names, padded to a whole word
+//
+// Offsets are in bytes from the start of the image.
+//
+
+namespace glslang {
+
+const uint32_t ReflectionBinaryMagic = 0x46524c47;  // "GLRF"
+const uint32_t ReflectionBinaryVersion = 1;
+const uint32_t ReflectionBinaryNoName = 0xffffffff;  // marks an empty name-table entry
+
+// The reflected objects, in the order of TProgram's reflection getters
+enum TReflectionBinarySection {
+    EReflectionUniform,
+    EReflectionUniformBlock,
+    EReflectionBufferVariable,
+    EReflectionBufferBlock,
+    EReflectionPipeInput,
+    EReflectionPipeOutput,
+    EReflectionSectionCount
+};
+
+// The name tables, for getReflectionIndex() and getReflectionPipeIOIndex()
+enum TReflectionBinaryNames {
+    EReflectionNames,
+    EReflectionPipeInputNames,
+    EReflectionPipeOutputNames,
+    EReflectionNamesCount
+};
+
+struct TReflectionBinaryRange {
+    uint32_t offset;
+    uint32_t count;  // of elements; of bytes for the names
+};
+
+struct TReflectionBinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;  // of the whole image, in bytes
+    uint32_t localSize[3];
+    TReflectionBinaryRange sections[EReflectionSectionCount];
+    TReflectionBinaryRange atomicCounters;
+    TReflectionBinaryRange nameTables[EReflectionNamesCount];  // count is a power of two
+    TReflectionBinaryRange names;
+};
+
+// One TObjectReflection
+struct TReflectionBinaryRecord {
+    uint32_t name;  // offset into the names
+    int32_t offset;
+    int32_t glDefineType;
+    int32_t size;
+    int32_t index;
+    int32_t counterIndex;
+    int32_t numMembers;
+    int32_t arrayStride;
+    int32_t topLevelArraySize;
+    int32_t topLevelArrayStride;
+    uint32_t stages;  // EShLanguageMask
+    int32_t binding;
+    uint32_t location;
+};
+
+struct TReflectionBinaryNameEntry {
+    uint32_t name;  // offset into the names, or ReflectionBinaryNoName
+    int32_t index;
+};
+
+// FNV-1a; name tables are probed linearly from hash & (count - 1)
+inline uint32_t ReflectionBinaryHash(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name != 0; ++name)
+        hash = (hash ^ (unsigned char)*name) * 16777619u;
+    return hash;
+}
+
+//
+// Zero-copy reader of a reflection image.  The image is not copied: it must stay
+// mapped, and be 4-byte aligned, for as long as the reader is used.
+//
+class TReflectionBinary {
+public:
+    TReflectionBinary() : image(nullptr), header(nullptr) { }
+
+    // Returns false, leaving the reader empty, if 'data' is not a well-formed image
+    // of this version and byte order.
+    bool init(const void* data, size_t size)
+    {
+        image = nullptr;
+        header = nullptr;
+        if (data == nullptr || size < sizeof(TReflectionBinaryHeader) || ((uintptr_t)data & 3) != 0)
+            return false;
+
+        const TReflectionBinaryHeader* candidate = static_cast<const TReflectionBinaryHeader*>(data);
+        if (candidate->magic != ReflectionBinaryMagic || candidate->version != ReflectionBinaryVersion ||
+            candidate->size > size)
+            return false;
+
+        const size_t imageSize = candidate->size;
+        for (int s = 0; s < EReflectionSectionCount; ++s) {
+            if (! validRange(candidate->sections[s], sizeof(TReflectionBinaryRecord), imageSize))
+                return false;
+        }
+        if (! validRange(candidate->atomicCounters, sizeof(int32_t), imageSize))
+            return false;
+        for (int n = 0; n < EReflectionNamesCount; ++n) {
+            const uint32_t count = candidate->nameTables[n].count;
+            if ((count & (count - 1)) != 0 ||
+                ! validRange(candidate->nameTables[n], sizeof(TReflectionBinaryNameEntry), imageSize))
+                return false;
+        }
+        const TReflectionBinaryRange& names = candidate->names;
+        if (names.count == 0 || ! validRange(names, 1, imageSize) ||
+            static_cast<const char*>(data)[names.offset + names.count - 1] != 0)
+            return false;
+
+        image = static_cast<const char*>(data);
+        header = candidate;
+
+        return true;
+    }
+
+    bool valid() const { return header != nullptr; }
+
+    int getNumRecords(TReflectionBinarySection section) const
+    {
+        return header != nullptr ? (int)header->sections[section].count : 0;
+    }
+
+    // nullptr when out of range
+    const TReflectionBinaryRecord* getRecord(TReflectionBinarySection section, int i) const
+    {
+        if (i < 0 || i >= getNumRecords(section))
+            return nullptr;
+        return reinterpret_cast<const TReflectionBinaryRecord*>(image + header->sections[section].offset) + i;
+    }
+
+    int getNumAtomicCounters() const { return header != nullptr ? (int)header->atomicCounters.count : 0; }
+    const TReflectionBinaryRecord* getAtomicCounter(int i) const
+    {
+        if (i < 0 || i >= getNumAtomicCounters())
+            return nullptr;
+        const int32_t* indices = reinterpret_cast<const int32_t*>(image + header->atomicCounters.offset);
+        return getRecord(EReflectionUniform, indices[i]);
+    }
+
+    const char* getName(const TReflectionBinaryRecord& record) const { return getString(record.name); }
+
+    // Same as TProgram::getReflectionIndex(): -1 if the name is not known.
+    int getIndex(const char* name) const { return lookup(EReflectionNames, name); }
+
+    // Same as TProgram::getReflectionPipeIOIndex(): -1 if the name is not known.
+    int getPipeIOIndex(const char* name, bool inOrOut) const
+    {
+        return lookup(inOrOut ? EReflectionPipeInputNames : EReflectionPipeOutputNames, name);
+    }
+
+    unsigned getLocalSize(int dim) const { return header != nullptr && dim >= 0 && dim <= 2 ? header->localSize[dim] : 0; }
+
+protected:
+    static bool validRange(const TReflectionBinaryRange& range, size_t elementSize, size_t imageSize)
+    {
+        return (range.offset & 3) == 0 && range.offset <= imageSize &&
+               range.count <= (imageSize - range.offset) / elementSize;
+    }
+
+    const char* getString(uint32_t offset) const
+    {
+        if (offset >= header->names.count)
+            return "";
+        return image + header->names.offset + offset;
+    }
+
+    int lookup(TReflectionBinaryNames table, const char* name) const
+    {
+        if (header == nullptr || header->nameTables[table].count == 0)
+            return -1;
+
+        const TReflectionBinaryNameEntry* entries =
+            reinterpret_cast<const TReflectionBinaryNameEntry*>(image + header->nameTables[table].offset);
+        const uint32_t mask = header->nameTables[table].count - 1;
+        for (uint32_t probe = 0, slot = ReflectionBinaryHash(name) & mask; probe <= mask;
+             ++probe, slot = (slot + 1) & mask) {
+            if (entries[slot].name == ReflectionBinaryNoName)
+                return -1;
+            if (strcmp(getString(entries[slot].name), name) == 0)
+                return entries[slot].index;
+        }
+
+        return -1;
+    }
+
+    const char* image;
+    const TReflectionBinaryHeader* header;
+};
+
+} // end namespace glslang
+
+#endif // _REFLECTION_BINARY_INCLUDED_
@@ -287,6 +287,7 @@ typedef enum {
     EShReflectionAllIOVariables     = (1 << 6), // reflect all input/output variables, even if they are inactive
     EShReflectionSharedStd140SSBO   = (1 << 7), // Apply std140/shared rules for ubo to ssbo
     EShReflectionSharedStd140UBO    = (1 << 8), // Apply std140/shared rules for ubo to ssbo
+    EShReflectionParallelStages     = (1 << 9), // traverse stages concurrently, merging them as if in order
     LAST_ELEMENT_MARKER(EShReflectionCount),
 } EShReflectionOptions;
 
@@ -441,6 +442,39 @@ enum TBlockStorageClass
     EbsCount,
 };
 
+// Hot-path events of a compile, counted to find out why a shader is slow without
+// attaching a profiler.  They are only counted when glslang is built with the CMake
+// option ENABLE_COUNTERS (see CountersEnabled()); otherwise all counts stay 0.
+enum TCounter {
+    ECounterSymbolFinds,          // TSymbolTable::find() calls
+    ECounterSymbolLevelsProbed,   // scopes searched by those calls
+    ECounterFunctionCandidates,   // overloads returned by TSymbolTable::findFunctionNameList()
+    ECounterTypeCopies,           // TType::shallowCopy() calls, including those of deep copies
+    ECounterTypeDeepCopies,       // TType::deepCopy() calls
+    ECounterPoolBytes,            // bytes requested from pool allocators
+    ECounterSpvTypeProbes,        // cached types spv::Builder compared while making types
+    ECounterSpvConstantProbes,    // cached constants spv::Builder compared while making constants
+    ECounterMacroExpansions,      // macro invocations expanded by the preprocessor
+    ECounterTokensScanned,        // tokens read by the preprocessor, macro bodies included
+    ECounterCount
+};
+
+struct TCompileCounters {
+    TCompileCounters() { reset(); }
+    void reset()
+    {
+        for (int c = 0; c < ECounterCount; ++c)
+            count[c] = 0;
+    }
+    unsigned long long operator[](TCounter counter) const { return count[counter]; }
+    GLSLANG_EXPORT static const char* getName(TCounter);
+
+    unsigned long long count[ECounterCount];
+};
+
+// Whether this build of glslang counts the events of TCompileCounters
+GLSLANG_EXPORT bool CountersEnabled();
+
 // Make one TShader per shader that you will link into a program. Then
 //  - provide the shader through setStrings() or setStringsWithLengths()
 //  - optionally call setEnv*(), see below for more detail
@@ -467,6 +501,10 @@ public:
         const char* const* s, const int* l, int n);
     GLSLANG_EXPORT void setStringsWithLengthsAndNames(
         const char* const* s, const int* l, const char* const* names, int n);
+    // Promise that the strings given to setStrings*() stay valid and unchanged for the life of
+    // this TShader (e.g., they are a mapped file), so that parse() can refer to them instead of
+    // copying them where it keeps source text, as for EShMsgDebugInfo.
+    void setStringsRetained(bool retained) { stringsRetained = retained; }
     void setPreamble(const char* s) { preamble = s; }
     GLSLANG_EXPORT void setEntryPoint(const char* entryPoint);
     GLSLANG_EXPORT void setSourceEntryPoint(const char* sourceEntryPointName);
@@ -688,11 +726,27 @@ public:
         bool forwardCompatible, EShMessages message, std::string* outputString,
         Includer& includer);
 
+    // Runs only the preprocessor, like preprocess(), but without building any text:
+    // sets "fingerprint" to a hash of the token stream instead.  The hash covers each
+    // token's kind and spelling (literals by value), the #extension and #pragma directives,
+    // the version and profile in effect, and the stage, so it is unchanged by comments,
+    // whitespace, #line, or rearranging macros and #includes that expand to the same tokens.
+    // It does not cover the other compile options, which a cache key must add itself.
+    // Returns false on a preprocessing error.
+    GLSLANG_EXPORT bool fingerprint(
+        const TBuiltInResource* builtInResources, int defaultVersion,
+        EProfile defaultProfile, bool forceDefaultVersionAndProfile,
+        bool forwardCompatible, EShMessages message, unsigned long long* fingerprint,
+        Includer& includer);
+
     GLSLANG_EXPORT const char* getInfoLog();
     GLSLANG_EXPORT const char* getInfoDebugLog();
     EShLanguage getStage() const { return stage; }
     TIntermediate* getIntermediate() const { return intermediate; }
 
+    // Counts of the last parse(), preprocess() or fingerprint(); see TCompileCounters
+    const TCompileCounters& getCounters() const { return counters; }
+
 protected:
     TPoolAllocator* pool;
     EShLanguage stage;
@@ -712,6 +766,7 @@ protected:
     const int* lengths;
     const char* const* stringNames;
     int numStrings;                  // size of the above arrays
+    bool stringsRetained = false;    // see setStringsRetained()
     const char* preamble;            // string of implicit code to compile before the explicitly provided code
 
     // a function in the source string can be renamed FROM this TO the name given in setEntryPoint.
@@ -725,6 +780,8 @@ protected:
     // Indicates this shader is meant to be used without linking
     bool compileOnly = false;
 
+    TCompileCounters counters;
+
     friend class TProgram;
 
 private:
@@ -868,6 +925,20 @@ public:
 
     TIntermediate* getIntermediate(EShLanguage stage) const { return intermediate[stage]; }
 
+    // Counts of linking a stage; see TCompileCounters.  GlslangToSpv() counts into its
+    // spv::SpvBuildLogger instead, so it never changes the program.
+    const TCompileCounters& getCounters(EShLanguage stage) const { return counters[stage]; }
+
+    // Freeze a linked program, after any mapIO() and buildReflection() it needs; returns false
+    // if it is not linked.  A frozen program is never changed again, and link(), mapIO() and
+    // buildReflection() fail on it.  Its intermediates can then be read from several threads
+    // at once, e.g., GlslangToSpv() of each stage on a thread of its own, provided each thread
+    // allocates from its own pool (see GetThreadPoolAllocator()), and never from this
+    // program's.  N.B. the shaders linked into the program are read as well, so they must not
+    // be used to parse again while frozen programs still use them.
+    GLSLANG_EXPORT bool freeze();
+    bool isFrozen() const { return frozen; }
+
     // Reflection Interface
 
     // call first, to do liveness analysis, index mapping, etc.; returns false on failure
@@ -956,6 +1027,8 @@ public:
     const TType *getAttributeTType(int index) const    { return getPipeInput(index).getType(); }
 
     GLSLANG_EXPORT void dumpReflection();
+    // serialize the reflection for TReflectionBinary (see ReflectionBinary.h); false if not built
+    GLSLANG_EXPORT bool getReflectionBinary(std::vector<unsigned int>& words) const;
     // I/O mapping: apply base offsets and map live unbound variables
     // If resolver is not provided it uses the previous approach
     // and respects auto assignment and offsets.
@@ -972,6 +1045,8 @@ protected:
     TInfoSink* infoSink;
     TReflection* reflection;
     bool linked;
+    bool frozen = false;
+    TCompileCounters counters[EShLangCount];
 
 private:
     TProgram(TProgram&);
@@ -0,0 +1,150 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+size_t CountOccurrences(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+        ++count;
+    return count;
+}
+
+// With no texture coordinates, the compatibility built-ins declare zero-sized arrays, so the
+// context-specific built-ins do not parse.  Each compile of that context, whether it is the
+// first or finds the failure cached, reports it exactly once.
+TEST(BuiltInSymbols, FailingContextReportsOncePerCompile)
+{
+    TBuiltInResource resources = *GetDefaultResources();
+    resources.maxTextureCoords = 0;
+    const char* source = "#version 110\nvoid main() { gl_FragColor = vec4(1.0); }\n";
+
+    for (int compile = 0; compile < 3; ++compile) {
+        glslang::TShader shader(EShLangFragment);
+        shader.setStrings(&source, 1);
+
+        testing::internal::CaptureStdout();
+        shader.parse(&resources, 110, false, EShMsgDefault);
+        const std::string printed = testing::internal::GetCapturedStdout();
+
+        // the banner prints the built-ins that failed, which the info log does not hold
+        EXPECT_EQ(1u, CountOccurrences(printed, "gl_MaxTextureCoords = 0;")) << "compile " << compile;
+        EXPECT_EQ(1u, CountOccurrences(shader.getInfoLog(), "INTERNAL ERROR: Unable to parse built-ins"))
+            << "compile " << compile;
+    }
+}
+
+// Version 450 under relaxed Vulkan rules is a context no other test compiles, so its
+// built-in function prototypes are all still deferred when these tests first look.
+void ParseRelaxed(glslang::TShader& shader, const char* source)
+{
+    shader.setStrings(&source, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, shader.getStage(), glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    shader.setEnvInputVulkanRulesRelaxed();
+    const EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules | EShMsgAST);
+    EXPECT_TRUE(shader.parse(GetDefaultResources(), 450, false, messages)) << shader.getInfoLog();
+}
+
+// Several threads look up the same deferred families for the first time at once: each gets
+// them parsed once, with the operators they relate to, and so the same tree.
+TEST(BuiltInSymbols, FirstLookupFromManyThreads)
+{
+    const char* source = "#version 450\n"
+                         "layout(local_size_x = 1) in;\n"
+                         "layout(binding = 0) buffer B { uint u; int i; float f; };\n"
+                         "void main() { u = bitfieldReverse(u) + uint(bitCount(i)); i = findMSB(i);\n"
+                         "              f = fma(f, f, f) + smoothstep(0.0, 1.0, f); }\n";
+
+    const int threadCount = 8;
+    std::vector<std::string> trees(threadCount);
+    std::atomic<int> waiting(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            // start together, for the best chance of racing to the first lookup
+            --waiting;
+            while (waiting.load() > 0)
+                std::this_thread::yield();
+
+            glslang::TShader shader(EShLangCompute);
+            ParseRelaxed(shader, source);
+            trees[t] = std::string(shader.getInfoLog()) + shader.getInfoDebugLog();
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_NE(std::string::npos, trees[0].find("bitFieldReverse"));
+    EXPECT_EQ(std::string::npos, trees[0].find("Function Call:")) << trees[0];
+    for (int t = 1; t < threadCount; ++t)
+        EXPECT_EQ(trees[0], trees[t]) << "thread " << t;
+}
+
+// A family first looked up after the context was used for the built-ins it does not defer,
+// here its variables and constants, still parses, as the operator it relates to.
+TEST(BuiltInSymbols, DeferredAfterNonDeferred)
+{
+    glslang::TShader first(EShLangFragment);
+    ParseRelaxed(first, "#version 450\n"
+                        "layout(location = 0) out vec4 color;\n"
+                        "void main() { color = gl_FragCoord * float(gl_MaxDrawBuffers); }\n");
+    EXPECT_EQ(std::string::npos, std::string(first.getInfoDebugLog()).find("refract"));
+
+    glslang::TShader second(EShLangFragment);
+    ParseRelaxed(second, "#version 450\n"
+                         "layout(location = 0) out vec4 color;\n"
+                         "void main() { color = refract(gl_FragCoord, vec4(1.0), 0.5); }\n");
+    const std::string tree = second.getInfoDebugLog();
+    EXPECT_NE(std::string::npos, tree.find("refract ( global highp 4-component vector of float)")) << tree;
+    EXPECT_EQ(std::string::npos, tree.find("Function Call:")) << tree;
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
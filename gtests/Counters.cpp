@@ -0,0 +1,113 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/GlslangToSpv.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+// Has a macro, a struct to copy, and a call that needs a conversion to find its function
+const char* const CountedSource =
+    "#version 450\n"
+    "#define SCALE(x) ((x) * 2.0)\n"
+    "struct Light { vec4 color; float power; };\n"
+    "layout(binding = 0) uniform Lights { Light lights[2]; };\n"
+    "layout(location = 0) in vec4 inColor;\n"
+    "layout(location = 0) out vec4 color;\n"
+    "float brightness(float power) { return power; }\n"
+    "void main() { Light l = lights[1]; color = SCALE(inColor) * l.color * brightness(1); }\n";
+
+// With ENABLE_COUNTERS, parsing, linking and SPIR-V generation each count the events they
+// go through; without it, every count stays 0.
+TEST(Counters, PopulatedWhenEnabled)
+{
+    const EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
+    glslang::TShader shader(EShLangFragment);
+    shader.setStrings(&CountedSource, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangFragment, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    ASSERT_TRUE(shader.parse(GetDefaultResources(), 100, false, messages)) << shader.getInfoLog();
+
+    glslang::TProgram program;
+    program.addShader(&shader);
+    ASSERT_TRUE(program.link(messages)) << program.getInfoLog();
+
+    std::vector<unsigned int> spirv;
+    spv::SpvBuildLogger logger;
+    glslang::GlslangToSpv(*program.getIntermediate(EShLangFragment), spirv, &logger);
+    ASSERT_FALSE(spirv.empty());
+
+    const glslang::TCompileCounters& parsed = shader.getCounters();
+    const glslang::TCompileCounters& linked = program.getCounters(EShLangFragment);
+    const glslang::TCompileCounters& generated = logger.getCounters();
+    const struct {
+        const glslang::TCompileCounters& counters;
+        glslang::TCounter counter;
+    } expected[] = {
+        { parsed, glslang::ECounterSymbolFinds },
+        { parsed, glslang::ECounterSymbolLevelsProbed },
+        { parsed, glslang::ECounterFunctionCandidates },
+        { parsed, glslang::ECounterTypeCopies },
+        { parsed, glslang::ECounterTypeDeepCopies },
+        { parsed, glslang::ECounterPoolBytes },
+        { parsed, glslang::ECounterMacroExpansions },
+        { parsed, glslang::ECounterTokensScanned },
+        { linked, glslang::ECounterPoolBytes },
+        { generated, glslang::ECounterSpvTypeProbes },
+        { generated, glslang::ECounterSpvConstantProbes },
+    };
+
+    if (glslang::CountersEnabled()) {
+        for (const auto& e : expected)
+            EXPECT_GT(e.counters[e.counter], 0u) << glslang::TCompileCounters::getName(e.counter);
+    } else {
+        for (int c = 0; c < glslang::ECounterCount; ++c) {
+            const glslang::TCounter counter = (glslang::TCounter)c;
+            EXPECT_EQ(0u, parsed[counter] + linked[counter] + generated[counter])
+                << glslang::TCompileCounters::getName(counter);
+        }
+    }
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
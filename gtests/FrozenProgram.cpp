@@ -0,0 +1,152 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/GlslangToSpv.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+const char* const VertexSource =
+    "#version 450\n"
+    "layout(location = 0) in vec4 position;\n"
+    "layout(location = 0) out vec4 color;\n"
+    "layout(binding = 0) uniform Transform { mat4 mvp; vec4 tint; };\n"
+    "void main() { gl_Position = mvp * position; color = tint; }\n";
+
+const char* const FragmentSource =
+    "#version 450\n"
+    "layout(location = 0) in vec4 color;\n"
+    "layout(location = 0) out vec4 fragColor;\n"
+    "layout(binding = 1) uniform sampler2D image;\n"
+    "void main() { fragColor = color * texture(image, color.xy); }\n";
+
+const EShMessages VulkanMessages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
+
+void Parse(glslang::TShader& shader, const char* source)
+{
+    shader.setStrings(&source, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, shader.getStage(), glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    ASSERT_TRUE(shader.parse(GetDefaultResources(), 100, false, VulkanMessages)) << shader.getInfoLog();
+}
+
+const EShLanguage Stages[] = { EShLangVertex, EShLangFragment };
+
+// Several threads translate both stages of one frozen program while it also rejects
+// mapIO() and buildReflection() and answers reflection queries; each translation
+// matches the one made before the threads started.
+TEST(FrozenProgram, ConcurrentReaders)
+{
+    glslang::TShader vertex(EShLangVertex);
+    glslang::TShader fragment(EShLangFragment);
+    Parse(vertex, VertexSource);
+    Parse(fragment, FragmentSource);
+
+    glslang::TProgram program;
+    program.addShader(&vertex);
+    program.addShader(&fragment);
+    ASSERT_TRUE(program.link(VulkanMessages)) << program.getInfoLog();
+    ASSERT_TRUE(program.mapIO());
+    ASSERT_TRUE(program.buildReflection());
+    ASSERT_TRUE(program.freeze());
+
+    std::vector<unsigned int> expected[2];
+    for (int s = 0; s < 2; ++s) {
+        glslang::GlslangToSpv(*program.getIntermediate(Stages[s]), expected[s]);
+        ASSERT_FALSE(expected[s].empty());
+    }
+    const int uniformBlocks = program.getNumUniformBlocks();
+    const int uniforms = program.getNumUniformVariables();
+
+    const int threadCount = 8;
+    std::vector<std::vector<unsigned int>> spirv(threadCount);
+    std::vector<int> rejected(threadCount, 0);
+    std::vector<int> reflected(threadCount, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            // each thread allocates from its own default pool
+            glslang::GlslangToSpv(*program.getIntermediate(Stages[t % 2]), spirv[t]);
+            if (! program.mapIO() && ! program.buildReflection())
+                rejected[t] = 1;
+            if (program.getNumUniformBlocks() == uniformBlocks && program.getNumUniformVariables() == uniforms)
+                reflected[t] = 1;
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (int t = 0; t < threadCount; ++t) {
+        EXPECT_EQ(expected[t % 2], spirv[t]) << "thread " << t;
+        EXPECT_EQ(1, rejected[t]) << "thread " << t;
+        EXPECT_EQ(1, reflected[t]) << "thread " << t;
+    }
+    EXPECT_TRUE(program.isFrozen());
+}
+
+// Only a linked program can be frozen, and a frozen one cannot be linked again.
+TEST(FrozenProgram, LinkFailsAfterFreeze)
+{
+    glslang::TShader vertex(EShLangVertex);
+    Parse(vertex, VertexSource);
+
+    glslang::TProgram program;
+    program.addShader(&vertex);
+    EXPECT_FALSE(program.freeze());
+    EXPECT_FALSE(program.isFrozen());
+
+    ASSERT_TRUE(program.link(VulkanMessages)) << program.getInfoLog();
+    ASSERT_TRUE(program.freeze());
+    const glslang::TIntermediate* intermediate = program.getIntermediate(EShLangVertex);
+
+    EXPECT_FALSE(program.link(VulkanMessages));
+    EXPECT_FALSE(program.mapIO());
+    EXPECT_FALSE(program.buildReflection());
+    EXPECT_TRUE(program.isFrozen());
+    EXPECT_EQ(intermediate, program.getIntermediate(EShLangVertex));
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
@@ -61,6 +61,7 @@ INSTANTIATE_TEST_SUITE_P(
         "preprocessor.include.disabled.vert",
         "preprocessor.line.vert",
         "preprocessor.line.frag",
+        "preprocessor.macro_cache.vert",
         "preprocessor.pragma.vert",
         "preprocessor.simple.vert",
         "preprocessor.success_if_parse_would_fail.vert",
@@ -0,0 +1,151 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "glslang/Include/glslang_c_interface.h"
+#include "glslang/MachineIndependent/localintermediate.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/resource_limits_c.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+// Split over two strings, so each string is a separate piece of source text
+const char* const RetainedSource[] = {
+    "#version 450\n",
+    "layout(location = 0) out vec4 color;\nvoid main() { color = vec4(1.0); }\n",
+};
+
+const int RetainedSourceCount = sizeof(RetainedSource) / sizeof(RetainedSource[0]);
+
+const EShMessages DebugInfoMessages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules | EShMsgDebugInfo);
+
+// Parses RetainedSource with debug info, which records the source text for OpSource
+void ParseWithDebugInfo(glslang::TShader& shader, bool retained)
+{
+    shader.setStrings(RetainedSource, RetainedSourceCount);
+    shader.setStringsRetained(retained);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangFragment, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    ASSERT_TRUE(shader.parse(GetDefaultResources(), 100, false, DebugInfoMessages)) << shader.getInfoLog();
+}
+
+// Retained strings are referenced in place: every piece of source text is the caller's own string.
+TEST(RetainedStrings, SourceTextReferencesCallerStrings)
+{
+    glslang::TShader shader(EShLangFragment);
+    ParseWithDebugInfo(shader, true);
+
+    const glslang::TIntermediate::TSourceText& text = shader.getIntermediate()->getSourceText();
+    ASSERT_EQ((size_t)RetainedSourceCount, text.size());
+    for (int s = 0; s < RetainedSourceCount; ++s) {
+        EXPECT_EQ(RetainedSource[s], text[s].first) << "string " << s << " was copied";
+        EXPECT_EQ(strlen(RetainedSource[s]), text[s].second);
+    }
+}
+
+// Without the promise, each piece is a copy with the same text.
+TEST(RetainedStrings, SourceTextCopiesUnretainedStrings)
+{
+    glslang::TShader shader(EShLangFragment);
+    ParseWithDebugInfo(shader, false);
+
+    const glslang::TIntermediate::TSourceText& text = shader.getIntermediate()->getSourceText();
+    ASSERT_EQ((size_t)RetainedSourceCount, text.size());
+    for (int s = 0; s < RetainedSourceCount; ++s) {
+        EXPECT_NE(RetainedSource[s], text[s].first);
+        EXPECT_EQ(std::string(RetainedSource[s]), std::string(text[s].first, text[s].second));
+    }
+}
+
+// The C interface parses its own preprocessed copy of input->code, which it keeps as source
+// text without copying again, so the caller's buffer can go as soon as it is preprocessed.
+TEST(RetainedStrings, CInterfaceOutlivesCallerCode)
+{
+    const std::string source = std::string(RetainedSource[0]) + RetainedSource[1];
+    char* code = new char[source.size() + 1];
+    memcpy(code, source.c_str(), source.size() + 1);
+
+    glslang_input_t input = {};
+    input.language = GLSLANG_SOURCE_GLSL;
+    input.stage = GLSLANG_STAGE_FRAGMENT;
+    input.client = GLSLANG_CLIENT_VULKAN;
+    input.client_version = GLSLANG_TARGET_VULKAN_1_0;
+    input.target_language = GLSLANG_TARGET_SPV;
+    input.target_language_version = GLSLANG_TARGET_SPV_1_0;
+    input.code = code;
+    input.default_version = 100;
+    input.default_profile = GLSLANG_NO_PROFILE;
+    input.messages = (glslang_messages_t)(GLSLANG_MSG_SPV_RULES_BIT | GLSLANG_MSG_VULKAN_RULES_BIT |
+                                          GLSLANG_MSG_DEBUG_INFO_BIT);
+    input.resource = glslang_default_resource();
+
+    glslang_shader_t* shader = glslang_shader_create(&input);
+    ASSERT_NE(nullptr, shader);
+    ASSERT_TRUE(glslang_shader_preprocess(shader, &input)) << glslang_shader_get_info_log(shader);
+    ASSERT_TRUE(glslang_shader_parse(shader, &input)) << glslang_shader_get_info_log(shader);
+
+    // overwrite, then free, the caller's code before anything reads source text again
+    memset(code, 'x', source.size());
+    delete [] code;
+    input.code = nullptr;
+
+    glslang_program_t* program = glslang_program_create();
+    glslang_program_add_shader(program, shader);
+    ASSERT_TRUE(glslang_program_link(program, input.messages)) << glslang_program_get_info_log(program);
+
+    glslang_spv_options_t options = {};
+    options.generate_debug_info = true;
+    options.disable_optimizer = true;
+    glslang_program_SPIRV_generate_with_options(program, input.stage, &options);
+
+    // OpSource carries the preprocessed text, which still holds the body of main()
+    const size_t bytes = glslang_program_SPIRV_get_size(program) * sizeof(unsigned int);
+    const std::string spirv((const char*)glslang_program_SPIRV_get_ptr(program), bytes);
+    EXPECT_NE(std::string::npos, spirv.find("void main() { color = vec4(1.0); }"));
+    EXPECT_EQ(std::string::npos, spirv.find("xxxx"));
+
+    glslang_program_delete(program);
+    glslang_shader_delete(shader);
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
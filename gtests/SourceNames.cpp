@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "glslang/MachineIndependent/localintermediate.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+// Named so that no other compile in the process holds it
+const char* const OutlivedName = "SourceNames.outlived.frag";
+
+// A location copied out of a compile, read after the TShader that named it is gone.
+TEST(SourceNames, LocationOutlivesShader)
+{
+    glslang::TSourceLoc loc;
+    {
+        const char* source = "#version 450\nvoid main() { }\n";
+        const int length = -1;
+        glslang::TShader shader(EShLangFragment);
+        shader.setStringsWithLengthsAndNames(&source, &length, &OutlivedName, 1);
+        ASSERT_TRUE(shader.parse(GetDefaultResources(), 100, false, EShMsgDefault)) << shader.getInfoLog();
+
+        glslang::TIntermAggregate* body = shader.getIntermediate()->getTreeRoot()->getAsAggregate();
+        ASSERT_NE(nullptr, body);
+        loc = body->getSequence().front()->getLoc();
+        ASSERT_STREQ(OutlivedName, loc.getFilename());
+        EXPECT_EQ("\"" + std::string(OutlivedName) + "\"", loc.getStringNameOrNum());
+    }
+
+    EXPECT_EQ(nullptr, loc.getFilename());
+    EXPECT_STREQ("", loc.getFilenameStr());
+    EXPECT_EQ(std::to_string(loc.string), loc.getStringNameOrNum());
+    EXPECT_EQ(std::to_string(loc.string), loc.getStringNameOrNum(false));
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
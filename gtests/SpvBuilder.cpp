@@ -0,0 +1,100 @@
+//
+// Copyright (C) 2025 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of 3Dlabs Inc. Ltd. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/SpvBuilder.h"
+
+namespace glslangtest {
+namespace {
+
+const unsigned int Guard = 0xdeadbeef;
+
+// A compute entry point with an if-else, so main() has blocks for dump() to order
+void BuildModule(spv::Builder& builder)
+{
+    builder.addCapability(spv::CapabilityShader);
+    builder.setMemoryModel(spv::AddressingModelLogical, spv::MemoryModelGLSL450);
+    spv::Function* entry = builder.makeEntryPoint("main");
+    builder.addEntryPoint(spv::ExecutionModelGLCompute, entry, "main");
+    builder.addExecutionMode(entry, spv::ExecutionModeLocalSize, 1, 1, 1);
+
+    spv::Builder::If ifBuilder(builder.makeBoolConstant(true), spv::SelectionControlMaskNone, builder);
+    ifBuilder.makeBeginElse();
+    ifBuilder.makeEndIf();
+
+    builder.makeReturn(true);
+    builder.leaveFunction();
+}
+
+// A buffer of exactly the module's size gets the same words as the vector dump, and nothing
+// past its end is touched.
+TEST(SpvBuilder, DumpToExactCapacity)
+{
+    spv::SpvBuildLogger logger;
+    spv::Builder builder(spv::Spv_1_0, 0, &logger);
+    BuildModule(builder);
+
+    std::vector<unsigned int> expected;
+    builder.dump(expected);
+    ASSERT_EQ(builder.getWordCount(), expected.size());
+
+    std::vector<unsigned int> words(expected.size() + 4, Guard);
+    ASSERT_EQ(expected.size(), builder.dump(words.data(), expected.size()));
+    EXPECT_EQ(expected, std::vector<unsigned int>(words.begin(), words.begin() + expected.size()));
+    for (size_t w = expected.size(); w < words.size(); ++w)
+        EXPECT_EQ(Guard, words[w]) << "word " << w << " is past the capacity";
+}
+
+// A buffer one word short, or none at all, gets nothing written, and 0 is returned.
+TEST(SpvBuilder, DumpToSmallCapacity)
+{
+    spv::SpvBuildLogger logger;
+    spv::Builder builder(spv::Spv_1_0, 0, &logger);
+    BuildModule(builder);
+
+    const size_t wordCount = builder.getWordCount();
+    std::vector<unsigned int> words(wordCount, Guard);
+    EXPECT_EQ(0u, builder.dump(words.data(), wordCount - 1));
+    EXPECT_EQ(std::vector<unsigned int>(wordCount, Guard), words);
+
+    EXPECT_EQ(0u, builder.dump(nullptr, 0));
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest